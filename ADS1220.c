@@ -31,7 +31,23 @@
 #include "ADS1220.h"
 
 //* Private Defines and Macros ---------------------------------------------------- //
-#define ADS1220_RawToAdcValue(oneData) ((int32_t)(((oneData[0] << 16) | (oneData[1] << 8) | (oneData[2])) << 8) / 256)
+#define ADS1220_RawToAdcValue(oneData) ((int32_t)(((uint32_t)(oneData)[0] << 24) | ((uint32_t)(oneData)[1] << 16) | ((uint32_t)(oneData)[2] << 8)) / 256)
+
+#define ADS1220_TimingOf(h) ((h)->Timing ? (h)->Timing : &ADS1220_DefaultTiming)
+#define ADS1220_CSLow(h)    ((h)->ADC_CS_Write ? (h)->ADC_CS_Write((h)->Context, 0) : (h)->ADC_CS_LOW())
+#define ADS1220_CSHigh(h)   ((h)->ADC_CS_Write ? (h)->ADC_CS_Write((h)->Context, 1) : (h)->ADC_CS_HIGH())
+#define ADS1220_TimeUS(h)   ((h)->ADC_GetTime_US ? (h)->ADC_GetTime_US((h)->Context) : 0)
+#define ADS1220_DRDYRead(h) ((h)->ADC_DRDY_Get ? (h)->ADC_DRDY_Get((h)->Context) : (h)->ADC_DRDY_Read())
+#define ADS1220_UseDOUT(h)  (!(h)->ADC_DRDY_Get && !(h)->ADC_DRDY_Read && (h)->ADC_MISO_Get) // No DRDY pin: DOUT/DRDY is read while CS is LOW
+#define ADS1220_DRDYLevel(h, DOUT) ((DOUT) ? (h)->ADC_MISO_Get((h)->Context) : ADS1220_DRDYRead(h))
+
+#ifndef ADS1220_MEMORY_BARRIER
+#if defined(__GNUC__) || defined(__clang__)
+#define ADS1220_MEMORY_BARRIER() __sync_synchronize()
+#else
+#define ADS1220_MEMORY_BARRIER()
+#endif
+#endif
 
 //* Others ------------------------------------------------------------------------ //
 #ifdef ADS1220_Debug_Enable
@@ -65,97 +81,246 @@ ADS1220Register_s {
   REGISTER03h						=	0x03,
 } ADS1220Register_t;
 
+/**
+ ** ==================================================================================
+ **                           ##### Private Variables #####                               
+ ** ==================================================================================
+ **/
+
+static const ADS1220_Timing_t ADS1220_DefaultTiming = ADS1220_TIMING_DEFAULT;
+
 /**
  *! ==================================================================================
  *!                          ##### Private Functions #####                               
  *! ==================================================================================
  **/
-static uint8_t
-ADS1220_ReadReg (ADS1220_Handler_t *ADC_Handler, ADS1220Register_t ADS1220REG)
-{
-	uint8_t RecByte = 0;
-  ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_LOW();
-	ADS1220_Delay_US(10);
-	ADC_Handler->ADC_Transmit(RREG | (ADS1220REG << 2));
-	ADS1220_Delay_US(10);
-	RecByte = ADC_Handler->ADC_Receive();
-	ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_HIGH();
-  ADS1220_Delay_US(10);
-	return RecByte;
+static void
+ADS1220_Select (ADS1220_Handler_t *ADC_Handler)
+{
+  const ADS1220_Timing_t *Timing = ADS1220_TimingOf(ADC_Handler);
+  ADS1220_CSLow(ADC_Handler);
+  if (Timing->CSSetup_US) ADS1220_Delay_US(Timing->CSSetup_US);
+};
+
+static void
+ADS1220_Deselect (ADS1220_Handler_t *ADC_Handler)
+{
+  const ADS1220_Timing_t *Timing = ADS1220_TimingOf(ADC_Handler);
+  if (Timing->CSHold_US) ADS1220_Delay_US(Timing->CSHold_US);
+  ADS1220_CSHigh(ADC_Handler);
+  if (Timing->CSHigh_US) ADS1220_Delay_US(Timing->CSHigh_US);
+};
+
+// Shifts Length bytes while CS is LOW
+// Per byte: ADC_TransmitReceive for every byte if it is initialized, ADC_Receive only for the dummy bytes of read frames
+static void
+ADS1220_Shift (ADS1220_Handler_t *ADC_Handler, const uint8_t *TxData, uint8_t *RxData, uint8_t Length)
+{
+  const ADS1220_Timing_t *Timing = ADS1220_TimingOf(ADC_Handler);
+  if (ADC_Handler->ADC_Transfer)
+  {
+    ADC_Handler->ADC_Transfer(ADC_Handler->Context, TxData, RxData, Length);
+  }
+  else
+  {
+    for (uint8_t i = 0; i < Length; i++)
+    {
+      if (i && Timing->InterByte_US) ADS1220_Delay_US(Timing->InterByte_US);
+      if (RxData && ADC_Handler->ADC_TransmitReceive) RxData[i] = ADC_Handler->ADC_TransmitReceive(TxData[i]);
+      else if (RxData && TxData[i] == 0)             RxData[i] = ADC_Handler->ADC_Receive(); // Dummy byte of a read frame (RDATA, RREG payload)
+      else { ADC_Handler->ADC_Transmit(TxData[i]); if (RxData) RxData[i] = 0; }
+    }
+  }
+};
+
+static void
+ADS1220_Frame (ADS1220_Handler_t *ADC_Handler, const uint8_t *TxData, uint8_t *RxData, uint8_t Length)
+{
+  ADS1220_Select(ADC_Handler);
+  ADS1220_Shift(ADC_Handler, TxData, RxData, Length);
+  ADS1220_Deselect(ADC_Handler);
+};
+
+static void
+ADS1220_Command (ADS1220_Handler_t *ADC_Handler, ADS1220Commands_t Command)
+{
+  uint8_t TxData = Command;
+  ADS1220_Frame(ADC_Handler, &TxData, NULL, 1);
+};
+
+
+// Leaving Continuous conversion mode stops the conversions (Setting it needs a START/SYNC)
+static void
+ADS1220_UpdatePowerState (ADS1220_Handler_t *ADC_Handler)
+{
+  if (ADC_Handler->PowerState == StateContinuous && !(ADC_Handler->RegShadow[1] & 0x04))
+    ADC_Handler->PowerState = StateIdle;
 };
 
-// This function Works but we do not need it
-//static void ADS1220_ReadAllRegs (ADS1220_Handler *ADC_Handler, uint8_t *ReadValues /*It is = [0]: REG00h | Number of Elements: 4*/)
-//{
-//  ADS1220_Delay_US(10);
-//	ADC_Handler->ADC_CS_LOW();
-//	ADS1220_Delay_US(10);
-//	ADC_Handler->ADC_Transmit(RREG | 3 /*(num reg to read: 4) - 1*/ /*starts from reg00h*/);
-//	ADS1220_Delay_US(10);
-//	ReadValues[0] = ADC_Handler->ADC_Receive();
-//	ADS1220_Delay_US(10);
-//  ReadValues[1] = ADC_Handler->ADC_Receive();
-//	ADS1220_Delay_US(10);
-//  ReadValues[2] = ADC_Handler->ADC_Receive();
-//	ADS1220_Delay_US(10);
-//  ReadValues[3] = ADC_Handler->ADC_Receive();
-//	ADS1220_Delay_US(10);
-//	ADC_Handler->ADC_CS_HIGH();
-//  ADS1220_Delay_US(10);
-//};
+static void
+ADS1220_WriteRegs (ADS1220_Handler_t *ADC_Handler, ADS1220Register_t ADS1220REG, uint8_t Count, const uint8_t *RegisterValue /*[0]: ADS1220REG*/)
+{
+  uint8_t TxData[5] = {WREG | (ADS1220REG << 2) | (Count - 1)};
+  for (uint8_t i = 0; i < Count; i++)
+  {
+    TxData[i + 1] = RegisterValue[i];
+    ADC_Handler->RegShadow[ADS1220REG + i] = RegisterValue[i];
+  }
+  ADS1220_Frame(ADC_Handler, TxData, NULL, Count + 1);
+  ADS1220_UpdatePowerState(ADC_Handler);
+};
 
 static void
 ADS1220_WriteReg (ADS1220_Handler_t *ADC_Handler, ADS1220Register_t ADS1220REG, uint8_t RegisterValue)
 {
-  ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_LOW();
-	ADS1220_Delay_US(10);
-	ADC_Handler->ADC_Transmit(WREG | (ADS1220REG << 2));
-	ADS1220_Delay_US(10);
-	ADC_Handler->ADC_Transmit(RegisterValue);
-	ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_HIGH();
-  ADS1220_Delay_US(10);
+  ADS1220_WriteRegs(ADC_Handler, ADS1220REG, 1, &RegisterValue);
 };
 
 static void
 ADS1220_WriteAllRegs (ADS1220_Handler_t *ADC_Handler, uint8_t *RegisterValue /*Must be = [0]: REG00h | Number of Elements: 4*/)
 {
-  ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_LOW();
-	ADS1220_Delay_US(10);
-	ADC_Handler->ADC_Transmit(WREG | 3 /*(num reg to write: 4) - 1*/ /*starts from reg00h*/);
-	ADS1220_Delay_US(10);
-	ADC_Handler->ADC_Transmit(RegisterValue[0]);
-	ADS1220_Delay_US(10);
-  ADC_Handler->ADC_Transmit(RegisterValue[1]);
-	ADS1220_Delay_US(10);
-  ADC_Handler->ADC_Transmit(RegisterValue[2]);
-	ADS1220_Delay_US(10);
-  ADC_Handler->ADC_Transmit(RegisterValue[3]);
-	ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_HIGH();
-  ADS1220_Delay_US(10);
+  ADS1220_WriteRegs(ADC_Handler, REGISTER00h, 4, RegisterValue);
+};
+
+// Reads the conversion data and writes registers in the same frame (Data is shifted out while WREG is shifted in)
+// Only in Continuous conversion mode with ADC_Transfer or ADC_TransmitReceive, otherwise two frames are used
+static void
+ADS1220_ReadDataWriteRegs (ADS1220_Handler_t *ADC_Handler, ADS1220Register_t ADS1220REG, uint8_t Count, const uint8_t *RegisterValue, int32_t *ADCSample)
+{
+  uint8_t TxData[6] = {0, WREG | (ADS1220REG << 2) | (Count - 1)};
+  uint8_t RxData[6] = {0};
+  if (!(ADC_Handler->RegShadow[1] & 0x04) || (!ADC_Handler->ADC_Transfer && !ADC_Handler->ADC_TransmitReceive))
+  {
+    // Single-shot mode or no full-duplex callback: Data and WREG in their own frames
+    ADS1220_ReadData(ADC_Handler, ADCSample);
+    ADS1220_WriteRegs(ADC_Handler, ADS1220REG, Count, RegisterValue);
+    return;
+  }
+  for (uint8_t i = 0; i < Count; i++)
+  {
+    TxData[i + 2] = RegisterValue[i];
+    ADC_Handler->RegShadow[ADS1220REG + i] = RegisterValue[i];
+  }
+  ADS1220_Frame(ADC_Handler, TxData, RxData, Count + 2);
+  *ADCSample = ADS1220_RawToAdcValue(RxData);
+  ADC_Handler->LastConversion_US = ADS1220_TimeUS(ADC_Handler);
+  ADS1220_UpdatePowerState(ADC_Handler);
+//  PROGRAMLOG("%x\r\n",(RxData[0]<<16) | (RxData[1]<<8) | (RxData[2]));
+};
+
+// Writes the smallest contiguous range of registers that differs from the shadow registers
+// If ADCSample is not NULL, the conversion data is read in the same frame
+// Returns false if nothing had to be written
+static bool
+ADS1220_ApplyImage (ADS1220_Handler_t *ADC_Handler, const uint8_t *Image /*[0]: REG00h | Number of Elements: 4*/, int32_t *ADCSample)
+{
+  int8_t First = -1, Last = -1;
+  for (int8_t i = 0; i < 4; i++)
+    if (Image[i] != ADC_Handler->RegShadow[i])
+    {
+      if (First < 0) First = i;
+      Last = i;
+    }
+  if (First < 0)
+  {
+    if (ADCSample) ADS1220_ReadData(ADC_Handler, ADCSample);
+    return false;
+  }
+  if (ADCSample) ADS1220_ReadDataWriteRegs(ADC_Handler, (ADS1220Register_t)First, Last - First + 1, &Image[First], ADCSample);
+  else           ADS1220_WriteRegs(ADC_Handler, (ADS1220Register_t)First, Last - First + 1, &Image[First]);
+  return true;
+};
+
+// Writes one register only if it differs from the shadow register
+static void
+ADS1220_UpdateReg (ADS1220_Handler_t *ADC_Handler, ADS1220Register_t ADS1220REG, uint8_t RegisterValue)
+{
+  if (ADC_Handler->RegShadow[ADS1220REG] != RegisterValue) ADS1220_WriteReg(ADC_Handler, ADS1220REG, RegisterValue);
 };
 
+// Packs Parameters into REG00h - REG03h | NULL: Default values
 static void
-ADS1220_ReadDataWriteReg (ADS1220_Handler_t *ADC_Handler, ADS1220Register_t ADS1220REG, uint8_t RegisterValue, int32_t *ADCSample)
-{
-  ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_LOW();
-	ADS1220_Delay_US(10);
-  ADC_Handler->ADCDataValues.Part3 = ADC_Handler->ADC_TransmitReceive(0);
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADCDataValues.Part2 = ADC_Handler->ADC_TransmitReceive(WREG | (ADS1220REG << 2));
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADCDataValues.Part1 = ADC_Handler->ADC_TransmitReceive(RegisterValue);
-	ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_HIGH();
-  ADS1220_Delay_US(10);
-  *ADCSample = ADC_Handler->ADCDataValues.INT32 / 256;
-//  PROGRAMLOG("%x\r\n",(ADCDataValues.Part3<<16) | (ADCDataValues.Part2<<8) | (ADCDataValues.Part1));
+ADS1220_PackParameters (const ADS1220_Parameters_t *Parameters, uint8_t *RegsValue /*[0]: REG00h | Number of Elements: 4*/)
+{
+  if (!Parameters)
+  {
+    for (uint8_t i = 0; i < 4; i++) RegsValue[i] = 0;
+    return;
+  }
+  RegsValue[0] = (Parameters->InputMuxConfig << 4) | (Parameters->GainConfig << 1) | Parameters->PGAdisable;
+  RegsValue[1] = (Parameters->DataRate << 5) | (Parameters->OperatingMode << 3) | (Parameters->ConversionMode << 2) | (Parameters->TempeSensorMode << 1) | Parameters->BurnOutCurrentSrc;
+  RegsValue[2] = (Parameters->VoltageRef << 6) | (Parameters->FIRFilter << 4) | (Parameters->LowSidePwr << 3) | Parameters->IDACcurrent;
+  RegsValue[3] = (Parameters->IDAC1routing << 5) | (Parameters->IDAC2routing << 2) | (Parameters->DRDYMode << 1);
+};
+
+// Conversion time of the current configuration
+static uint32_t
+ADS1220_ConversionUS (ADS1220_Handler_t *ADC_Handler, bool First)
+{
+  ADS1220_ConversionTiming_t Timing;
+  uint8_t Reg01hValue = ADC_Handler->RegShadow[1];
+  ADS1220_GetConversionTiming((ADS1220_DataRate_t)(Reg01hValue >> 5), (ADS1220_OperatingMode_t)((Reg01hValue >> 3) & 0x03),
+                              ADS1220_FCLK_HZ, &Timing);
+  return First ? Timing.FirstConversion_US : Timing.Period_US;
+};
+
+// One wake-up conversion, only after power up, RESET and POWERDOWN (or after ADS1220_WAKEUP_IDLE_US in Single-shot mode)
+static ADS1220_Result_t
+ADS1220_WakeUp (ADS1220_Handler_t *ADC_Handler)
+{
+  bool Needed = (ADC_Handler->PowerState == StatePowerDown);
+#if ADS1220_WAKEUP_IDLE_US
+  if (ADC_Handler->PowerState == StateIdle && ADC_Handler->ADC_GetTime_US &&
+      (uint32_t)(ADS1220_TimeUS(ADC_Handler) - ADC_Handler->LastConversion_US) > ADS1220_WAKEUP_IDLE_US)
+    Needed = true;
+#endif
+  if (!Needed) return ResultOK;
+  ADS1220_StartSync(ADC_Handler);
+  return ADS1220_WaitDRDY(ADC_Handler, ADS1220_ConversionUS(ADC_Handler, true));
+};
+
+// Warm restart check: The pending data is read, then DRDY must be HIGH and go LOW again
+// (Next conversion in Continuous conversion mode, otherwise one START/SYNC and conversion)
+static bool
+ADS1220_IsAlive (ADS1220_Handler_t *ADC_Handler)
+{
+  int32_t Sample;
+  if (!ADC_Handler->ADC_DRDY_Read && !ADC_Handler->ADC_DRDY_Get && !ADS1220_UseDOUT(ADC_Handler)) return false; // Can not check
+  ADS1220_ReadData(ADC_Handler, &Sample);
+  if (ADS1220_IsDataReady(ADC_Handler)) return false; // DRDY stuck LOW
+  if (ADC_Handler->RegShadow[1] & 0x04)
+  {
+    ADC_Handler->PowerState = StateContinuous;
+    if (ADS1220_WaitDRDY(ADC_Handler, ADS1220_ConversionUS(ADC_Handler, false)) == ResultOK) return true;
+  }
+  ADS1220_StartSync(ADC_Handler); // Single-shot mode, or powered down (POWERDOWN keeps the registers)
+  return ADS1220_WaitDRDY(ADC_Handler, ADS1220_ConversionUS(ADC_Handler, true)) == ResultOK;
+};
+
+// Runs a started scan to the end, one channel per DRDY
+static ADS1220_Result_t
+ADS1220_ScanWait (ADS1220_Handler_t *ADC_Handler, ADS1220_Scan_t *Scan)
+{
+  while (Scan->Busy)
+  {
+    if (ADS1220_WaitDRDY(ADC_Handler, ADS1220_ConversionUS(ADC_Handler, true)) != ResultOK)
+    {
+      ADC_Handler->Scan = NULL;
+      Scan->Busy = false;
+      ADS1220_ApplyImage(ADC_Handler, Scan->Restore, NULL);
+      return ResultTimeout;
+    }
+    ADS1220_OnDRDY(ADC_Handler);
+  }
+  return ResultOK;
+};
+
+static ADS1220_Result_t
+ADS1220_ScanBlocking (ADS1220_Handler_t *ADC_Handler, ADS1220_ScanType_t ScanType, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig)
+{
+  ADS1220_Scan_t Scan;
+  ADS1220_ScanStart(ADC_Handler, &Scan, ScanType, ADCSample, GainConfig, NULL);
+  return ADS1220_ScanWait(ADC_Handler, &Scan);
 };
 
 /**
@@ -164,6 +329,102 @@ ADS1220_ReadDataWriteReg (ADS1220_Handler_t *ADC_Handler, ADS1220Register_t ADS1
  ** ==================================================================================
  **/
 
+/**
+ * @brief  Calculates the minimum SPI timing profile from datasheet timing requirements
+ * @note   Each time is rounded up to the next MicroSecond.
+ * @param  Timing:      Pointer Of Timing Profile
+ * @param  SPIClock_Hz: SPI clock (SCLK) frequency in Hz
+ * @param  fCLK_Hz:     ADS1220 clock (fCLK) frequency in Hz | 4096000: Internal oscillator
+ * @retval None
+ */
+void
+ADS1220_TimingInit(ADS1220_Timing_t *Timing, uint32_t SPIClock_Hz, uint32_t fCLK_Hz)
+{
+  if (!Timing || !SPIClock_Hz || !fCLK_Hz) return;
+  Timing->CSSetup_US   = ADS1220_NS_TO_US(50);
+  Timing->CSHold_US    = ADS1220_NS_TO_US(25);
+  Timing->CSHigh_US    = ADS1220_NS_TO_US(20);
+  Timing->InterByte_US = ADS1220_NS_TO_US(1000000000UL / SPIClock_Hz);
+  Timing->Reset_US     = 50 + ADS1220_NS_TO_US(32000000000ULL / fCLK_Hz);
+}
+
+/**
+ * @brief  Conversion timing model of a configuration
+ * @note   Times are rounded up to the next MicroSecond. The 50/60Hz FIR filter only runs at 20SPS (Normal mode)
+ *         and 5SPS (Duty-cycle mode), so it is covered by those entries.
+ *         Duty-cycle mode converts like Normal mode at 4x the data rate and idles in between.
+ * @param  DataRate:      See ADS1220_DataRate enum
+ * @param  OperatingMode: See ADS1220_OperatingMode enum
+ * @param  fCLK_Hz:       ADS1220 clock (fCLK) frequency in Hz | 4096000: Internal oscillator
+ * @param  Timing:        Pointer Of Conversion Timing
+ * @retval None
+ */
+void
+ADS1220_GetConversionTiming(ADS1220_DataRate_t DataRate, ADS1220_OperatingMode_t OperatingMode, uint32_t fCLK_Hz, ADS1220_ConversionTiming_t *Timing)
+{
+  // First conversion in modulator clocks (tMOD: 16 * tCLK in Normal mode, 8 * tCLK in Turbo mode)
+  static const uint16_t FirstConversion_MOD[7] = {13955, 6258, 3152, 1604, 860, 476, 286};
+  // Normal mode data rates in 0.01SPS at fCLK = 4.096MHz
+  static const uint32_t DataRate_cSPS[7] = {2000, 4500, 9000, 17500, 33000, 60000, 100000};
+  uint8_t  Rate = (DataRate > _1000_SPS_) ? _1000_SPS_ : DataRate;
+  uint64_t Period_cUS = 10000000000ULL * 4096000ULL / ((uint64_t)DataRate_cSPS[Rate] * fCLK_Hz); // 0.01us
+  uint64_t First_NS = (uint64_t)FirstConversion_MOD[Rate] * ((OperatingMode == TurboMode) ? 8 : 16) * 1000000000ULL / fCLK_Hz;
+
+  if (OperatingMode == TurboMode) Period_cUS /= 2;
+  else if (OperatingMode == DutyCycleMode) Period_cUS *= 4;
+  Timing->Period_US = (uint32_t)((Period_cUS + 99) / 100);
+  Timing->FirstConversion_US = (uint32_t)((First_NS + 999) / 1000);
+}
+
+// Waits for DRDY LOW, see ADS1220_WaitDRDY | DOUT: CS is LOW and DOUT/DRDY is polled instead of the DRDY pin
+static ADS1220_Result_t
+ADS1220_WaitLevel (ADS1220_Handler_t *ADC_Handler, uint32_t Expected_US, bool DOUT)
+{
+  uint32_t Timeout_US = (uint32_t)((uint64_t)Expected_US * ADS1220_DRDY_TIMEOUT_PERCENT / 100) + ADS1220_DRDY_POLL_US;
+  uint32_t Sleep_US = (uint32_t)((uint64_t)Expected_US * ADS1220_DRDY_SLEEP_PERCENT / 100);
+  uint32_t Waited = Sleep_US;
+  uint32_t Start;
+
+  if (!ADS1220_DRDYLevel(ADC_Handler, DOUT)) return ResultOK;
+  Start = ADS1220_TimeUS(ADC_Handler);
+  if (Sleep_US)
+  {
+    if (ADC_Handler->ADC_Sleep_US) ADC_Handler->ADC_Sleep_US(ADC_Handler->Context, Sleep_US);
+    else ADS1220_Delay_US(Sleep_US);
+  }
+  while (ADS1220_DRDYLevel(ADC_Handler, DOUT))
+  {
+    if (ADC_Handler->ADC_GetTime_US) Waited = ADS1220_TimeUS(ADC_Handler) - Start;
+    else
+    {
+      ADS1220_Delay_US(ADS1220_DRDY_POLL_US);
+      Waited += ADS1220_DRDY_POLL_US;
+    }
+    if (Waited > Timeout_US) return ResultTimeout;
+  }
+  return ResultOK;
+};
+
+/**
+ * @brief  Waits for DRDY LOW without spinning for the whole conversion
+ * @note   Sleeps (ADC_Sleep_US, or ADC_Delay_US) for ADS1220_DRDY_SLEEP_PERCENT of Expected_US, then polls DRDY.
+ *         Gives up after ADS1220_DRDY_TIMEOUT_PERCENT of Expected_US (measured by ADC_GetTime_US if initialized).
+ *         Without DRDY pin callbacks, DOUT/DRDY is polled by ADC_MISO_Get while CS is held LOW.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Expected_US: Expected time to DRDY LOW in MicroSecond (See ADS1220_GetConversionTiming)
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time
+ */
+ADS1220_Result_t
+ADS1220_WaitDRDY(ADS1220_Handler_t *ADC_Handler, uint32_t Expected_US)
+{
+  ADS1220_Result_t Result;
+  if (!ADS1220_UseDOUT(ADC_Handler)) return ADS1220_WaitLevel(ADC_Handler, Expected_US, false);
+  ADS1220_Select(ADC_Handler);
+  Result = ADS1220_WaitLevel(ADC_Handler, Expected_US, true);
+  ADS1220_Deselect(ADC_Handler);
+  return Result;
+}
+
 /**
  * @brief  Initializes The ADC and Library
  * @note   If You pass Parameters as NULL, All Settings will set default. See ADS1220_Parameters struct to know what are default values
@@ -176,55 +437,65 @@ ADS1220_Init(ADS1220_Handler_t *ADC_Handler, ADS1220_Parameters_t * Parameters)
 {
   PROGRAMLOG("------------------------------\r\nADS1220_Init...\r\n");
   if (!ADC_Handler) { PROGRAMLOG("ERROR Please Initialize ADC_Handler\r\n"); return; }
-  PROGRAMLOG("%s",((ADC_Handler->ADC_TransmitReceive != NULL) & (ADC_Handler->ADC_DRDY_Read != NULL)) ? ("") : ("*** Warning! You Can NOT Use ReadAllContinuous Functions. ***\r\n*** Initialize both ADC_TransmitReceive and ADC_DRDY_Read in ADC_Handler struct ***\r\n\r\n"));
-  
-	ADS1220_Delay_US(100); // Wait after power up at least 50us + tclk
-  ADC_Handler->ADC_CS_LOW();
-	ADS1220_Delay_US(5);
-	ADC_Handler->ADC_Transmit(RESET_ADC);
-	ADS1220_Delay_US(5);
-	ADC_Handler->ADC_CS_HIGH();
-	ADS1220_Delay_US(100); // Wait after reset at least 50us + tclk
+  PROGRAMLOG("%s",(ADC_Handler->ADC_DRDY_Read != NULL || ADC_Handler->ADC_DRDY_Get != NULL || ADC_Handler->ADC_MISO_Get != NULL) ? ("") : ("*** Warning! You Can NOT Use ReadAll, ReadSequence and Scan Functions. ***\r\n*** Initialize ADC_DRDY_Read (or ADC_DRDY_Get, or ADC_MISO_Get) in ADC_Handler struct ***\r\n\r\n"));
+  PROGRAMLOG("%s",(ADC_Handler->ADC_Transfer != NULL || ADC_Handler->ADC_TransmitReceive != NULL) ? ("") : ("*** Note: Data reads and register writes use separate frames. Initialize ADC_Transfer (or ADC_TransmitReceive) to merge them in Continuous conversion mode ***\r\n\r\n"));
   
-  PROGRAMLOG("Previous Regs Values: 0x%02X | 0x%02X | 0x%02X | 0x%02X\r\n",
-    ADS1220_ReadReg(ADC_Handler,REGISTER00h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER01h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER02h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER03h)
-  );
+  ADS1220_Delay_US(ADS1220_TimingOf(ADC_Handler)->Reset_US); // Wait after power up at least 50us + 32 * tclk
+  ADS1220_Reset(ADC_Handler);
   
-  uint8_t RegsValue[4] = {0};
+  uint8_t RegsValue[4];
+  ADS1220_PackParameters(Parameters, RegsValue);
+  ADS1220_WriteAllRegs(ADC_Handler, RegsValue);
+#ifdef ADS1220_Debug_Enable
+  ADS1220_VerifyShadow(ADC_Handler); // One burst RREG, logs a mismatch
+#endif
+};
+
+/**
+ * @brief  Initializes The ADC and Library, keeping the running configuration after a warm restart of the MCU
+ * @note   One burst RREG reads REG00h - REG03h. If they already equal Parameters and ADS1220 is alive (A fresh DRDY
+ *         HIGH to LOW transition after the pending data is read), RESET and register writes are skipped and Continuous
+ *         conversion mode keeps running without losing samples. In Single-shot mode, or if the conversions were stopped,
+ *         one START/SYNC and conversion proves it. All 0x00 or all 0xFF registers are never trusted.
+ *         Otherwise ADS1220 is reset and only the registers that differ from the default values are written (One WREG).
+ *         A DRDY source (ADC_DRDY_Read, ADC_DRDY_Get or ADC_MISO_Get with DRDYMode = 1) is needed for a warm restart.
+ *         If You pass Parameters as NULL, All Settings will be set as default.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Parameters:  Pointer Of ADC Parameters
+ * @retval true:  Warm restart, the configuration of ADS1220 was kept
+ *         false: ADS1220 was reset and configured
+ */
+bool
+ADS1220_InitFast(ADS1220_Handler_t *ADC_Handler, ADS1220_Parameters_t * Parameters)
+{
+  uint8_t RegsValue[4], Current[4];
+  bool Warm = true, Blank = true;
+  PROGRAMLOG("------------------------------\r\nADS1220_InitFast...\r\n");
+  if (!ADC_Handler) { PROGRAMLOG("ERROR Please Initialize ADC_Handler\r\n"); return false; }
   
-  if (Parameters)
+  ADS1220_Delay_US(ADS1220_TimingOf(ADC_Handler)->Reset_US); // Wait after power up at least 50us + 32 * tclk
+  ADS1220_PackParameters(Parameters, RegsValue);
+  ADS1220_ReadRegs(ADC_Handler, 0, 4, Current);
+  for (uint8_t i = 0; i < 4; i++)
   {
-    RegsValue[0] = (Parameters->InputMuxConfig << 4) | (Parameters->GainConfig << 1) | Parameters->PGAdisable;
-    RegsValue[1] = (Parameters->DataRate << 5) | (Parameters->OperatingMode << 3) | (Parameters->ConversionMode << 2) | (Parameters->TempeSensorMode << 1) | Parameters->BurnOutCurrentSrc;
-    RegsValue[2] = (Parameters->VoltageRef << 6) | (Parameters->FIRFilter << 4) | (Parameters->LowSidePwr << 3) | Parameters->IDACcurrent;
-    RegsValue[3] = (Parameters->IDAC1routing << 5) | (Parameters->IDAC2routing << 2) | (Parameters->DRDYMode << 1);
-    ADS1220_WriteAllRegs(ADC_Handler,RegsValue);
-    
-    PROGRAMLOG("New      Regs Values: 0x%02X | 0x%02X | 0x%02X | 0x%02X\r\n"
-               "Correct  Regs Values: 0x%02X | 0x%02X | 0x%02X | 0x%02X\r\n",
-    ADS1220_ReadReg(ADC_Handler,REGISTER00h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER01h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER02h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER03h),
-    RegsValue[0],RegsValue[1],RegsValue[2],RegsValue[3]
-    );
+    if (Current[i] != RegsValue[i]) Warm = false;
+    if (Current[i] != Current[0] || (Current[0] != 0x00 && Current[0] != 0xFF)) Blank = false;
+    ADC_Handler->RegShadow[i] = Current[i];
   }
-  else
+  // All 0x00 or all 0xFF can also be a missing device or a floating MISO
+  if (Warm && !Blank && ADS1220_IsAlive(ADC_Handler))
   {
-    ADS1220_WriteAllRegs(ADC_Handler,RegsValue);
-    
-    PROGRAMLOG("Defualt  Regs Mode:   0x%02X | 0x%02X | 0x%02X | 0x%02X\r\n"
-               "Must     Regs be:     0x00 | 0x00 | 0x00 | 0x00\r\n",
-    ADS1220_ReadReg(ADC_Handler,REGISTER00h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER01h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER02h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER03h)
-    );
+    PROGRAMLOG("Warm restart, configuration is kept\r\n");
+    return true;
   }
-};
+  
+  ADS1220_Reset(ADC_Handler);
+  ADS1220_ApplyImage(ADC_Handler, RegsValue, NULL);
+#ifdef ADS1220_Debug_Enable
+  ADS1220_VerifyShadow(ADC_Handler); // One burst RREG, logs a mismatch
+#endif
+  return false;
+}
 
 /**
  * @brief  Starts (in Single-shot mode) or Syncs (in Continuous conversion mode) Conversion
@@ -234,13 +505,8 @@ ADS1220_Init(ADS1220_Handler_t *ADC_Handler, ADS1220_Parameters_t * Parameters)
 void
 ADS1220_StartSync(ADS1220_Handler_t *ADC_Handler)
 {
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADC_CS_LOW();
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADC_Transmit(START_SYNC);
-  ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_HIGH();
-  ADS1220_Delay_US(10);
+  ADS1220_Command(ADC_Handler, START_SYNC);
+  ADC_Handler->PowerState = (ADC_Handler->RegShadow[1] & 0x04) ? StateContinuous : StateIdle;
 }
 
 /**
@@ -251,13 +517,10 @@ ADS1220_StartSync(ADS1220_Handler_t *ADC_Handler)
 void
 ADS1220_Reset(ADS1220_Handler_t *ADC_Handler)
 {
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADC_CS_LOW();
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADC_Transmit(RESET_ADC);
-  ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_HIGH();
-  ADS1220_Delay_US(100);
+  ADS1220_Command(ADC_Handler, RESET_ADC);
+  for (uint8_t i = 0; i < 4; i++) ADC_Handler->RegShadow[i] = 0; // All registers are reset to default values
+  ADC_Handler->PowerState = StatePowerDown;
+  ADS1220_Delay_US(ADS1220_TimingOf(ADC_Handler)->Reset_US); // Wait after reset at least 50us + 32 * tclk
 }
 
 /**
@@ -268,13 +531,8 @@ ADS1220_Reset(ADS1220_Handler_t *ADC_Handler)
 void
 ADS1220_PowerDown(ADS1220_Handler_t *ADC_Handler)
 {
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADC_CS_LOW();
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADC_Transmit(POWERDOWN);
-  ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_HIGH();
-  ADS1220_Delay_US(10);
+  ADS1220_Command(ADC_Handler, POWERDOWN);
+  ADC_Handler->PowerState = StatePowerDown;
 }
 
 /**
@@ -287,24 +545,45 @@ ADS1220_PowerDown(ADS1220_Handler_t *ADC_Handler)
 void
 ADS1220_ReadData(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample)
 {
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADC_CS_LOW();
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADCDataValues.Part3 = ADC_Handler->ADC_Receive();
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADCDataValues.Part2 = ADC_Handler->ADC_Receive();
-  ADS1220_Delay_US(10);
-  ADC_Handler->ADCDataValues.Part1 = ADC_Handler->ADC_Receive();
-  ADS1220_Delay_US(10);
-	ADC_Handler->ADC_CS_HIGH();
-  ADS1220_Delay_US(10);
-  *ADCSample = ADC_Handler->ADCDataValues.INT32 / 256;
+  uint8_t TxData[3] = {0};
+  uint8_t RxData[3] = {0};
+  ADS1220_Frame(ADC_Handler, TxData, RxData, 3);
+  *ADCSample = ADS1220_RawToAdcValue(RxData);
+  ADC_Handler->LastConversion_US = ADS1220_TimeUS(ADC_Handler);
 //  PROGRAMLOG("Data read: 0x%02X\r\n",*ADCSample);
 }
 
+/**
+ * @brief  Waits for DOUT/DRDY LOW and reads Data in the same frame (No DRDY pin needed)
+ * @note   ADC_MISO_Get must be initialized and DRDYMode must be 1 (See ADS1220_Parameters struct).
+ *         CS is held LOW while waiting, so the SPI bus is busy until the data is read.
+ *         In Single-shot mode call ADS1220_StartSync first.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Elements: 1
+ * @retval ResultOK | ResultTimeout: DOUT/DRDY did not go LOW in time
+ */
+ADS1220_Result_t
+ADS1220_ReadDataDOUT(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample)
+{
+  uint8_t TxData[3] = {0};
+  uint8_t RxData[3] = {0};
+  ADS1220_Result_t Result;
+  ADS1220_Select(ADC_Handler);
+  Result = ADS1220_WaitLevel(ADC_Handler, ADS1220_ConversionUS(ADC_Handler, ADC_Handler->PowerState != StateContinuous), true);
+  if (Result == ResultOK)
+  {
+    ADS1220_Shift(ADC_Handler, TxData, RxData, 3); // Data is shifted out right after DOUT/DRDY goes LOW
+    *ADCSample = ADS1220_RawToAdcValue(RxData);
+    ADC_Handler->LastConversion_US = ADS1220_TimeUS(ADC_Handler);
+  }
+  ADS1220_Deselect(ADC_Handler);
+  return Result;
+}
+
 /**
  * @brief  Changes the Configurations
  * @note   Pass Parameters as NULL to change settings to default Values. See ADS1220_Parameters struct to know what are default values
+ *         Only the contiguous range of registers that changed is written (One WREG), nothing is sent if no register changed.
  * @param  ADC_Handler: Pointer Of Library Handler
  * @param  Parameters:  Pointer Of ADC Parameters
  * @retval None
@@ -312,43 +591,12 @@ ADS1220_ReadData(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample)
 void
 ADS1220_ChangeConfig(ADS1220_Handler_t *ADC_Handler, ADS1220_Parameters_t * Parameters)
 {
-  PROGRAMLOG("Previous Regs Values: 0x%02X | 0x%02X | 0x%02X | 0x%02X\r\n",
-    ADS1220_ReadReg(ADC_Handler,REGISTER00h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER01h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER02h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER03h)
-  );
-  
-  uint8_t RegsValue[4] = {0};
-  if (Parameters)
-  {
-    RegsValue[0] = (Parameters->InputMuxConfig << 4) | (Parameters->GainConfig << 1) | Parameters->PGAdisable;
-    RegsValue[1] = (Parameters->DataRate << 5) | (Parameters->OperatingMode << 3) | (Parameters->ConversionMode << 2) | (Parameters->TempeSensorMode << 1) | Parameters->BurnOutCurrentSrc;
-    RegsValue[2] = (Parameters->VoltageRef << 6) | (Parameters->FIRFilter << 4) | (Parameters->LowSidePwr << 3) | Parameters->IDACcurrent;
-    RegsValue[3] = (Parameters->IDAC1routing << 5) | (Parameters->IDAC2routing << 2) | (Parameters->DRDYMode << 1);
-    ADS1220_WriteAllRegs(ADC_Handler,RegsValue);
-    
-    PROGRAMLOG("New      Regs Values: 0x%02X | 0x%02X | 0x%02X | 0x%02X\r\n"
-               "Correct  Regs Values: 0x%02X | 0x%02X | 0x%02X | 0x%02X\r\n",
-    ADS1220_ReadReg(ADC_Handler,REGISTER00h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER01h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER02h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER03h),
-    RegsValue[0],RegsValue[1],RegsValue[2],RegsValue[3]
-    );
-  }
-  else 
-  {
-    ADS1220_WriteAllRegs(ADC_Handler,RegsValue);
-    
-    PROGRAMLOG("Defualt  Regs Mode:   0x%02X | 0x%02X | 0x%02X | 0x%02X\r\n"
-               "Must     Regs be:     0x00 | 0x00 | 0x00 | 0x00\r\n",
-    ADS1220_ReadReg(ADC_Handler,REGISTER00h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER01h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER02h),
-    ADS1220_ReadReg(ADC_Handler,REGISTER03h)
-    );
-  }
+  uint8_t RegsValue[4];
+  ADS1220_PackParameters(Parameters, RegsValue);
+  if (!ADS1220_ApplyImage(ADC_Handler, RegsValue, NULL)) return; // Nothing changed
+#ifdef ADS1220_Debug_Enable
+  ADS1220_VerifyShadow(ADC_Handler);
+#endif
 }
 
 /**
@@ -361,9 +609,7 @@ ADS1220_ChangeConfig(ADS1220_Handler_t *ADC_Handler, ADS1220_Parameters_t * Para
 void
 ADS1220_ChangeGain(ADS1220_Handler_t *ADC_Handler, ADS1220_GainConfig_t GainConfig)
 {
-  PROGRAMLOG("Prevoius Gain: 2^%d\r\n",(ADS1220_ReadReg(ADC_Handler,REGISTER00h) >> 1) & 7);
-  ADS1220_WriteReg(ADC_Handler,REGISTER00h,ADS1220_ReadReg(ADC_Handler,REGISTER00h) & (0xF1 | (GainConfig << 1)));
-  PROGRAMLOG("New      Gain: 2^%d\r\n",(ADS1220_ReadReg(ADC_Handler,REGISTER00h) >> 1) & 7);
+  ADS1220_UpdateReg(ADC_Handler, REGISTER00h, (ADC_Handler->RegShadow[0] & 0xF1) | (GainConfig << 1));
 }
 
 /**
@@ -374,8 +620,7 @@ ADS1220_ChangeGain(ADS1220_Handler_t *ADC_Handler, ADS1220_GainConfig_t GainConf
 void
 ADS1220_ActivateSingleShotMode(ADS1220_Handler_t *ADC_Handler)
 {
-  ADS1220_WriteReg(ADC_Handler,REGISTER01h,ADS1220_ReadReg(ADC_Handler,REGISTER01h) & 0xFB);
-  PROGRAMLOG("Single-Shot Mode is %s\r\n",((ADS1220_ReadReg(ADC_Handler,REGISTER01h) >> 2) & 1) ? ("Deactive") : ("Active"));
+  ADS1220_UpdateReg(ADC_Handler, REGISTER01h, ADC_Handler->RegShadow[1] & 0xFB);
 }
 
 /**
@@ -386,8 +631,7 @@ ADS1220_ActivateSingleShotMode(ADS1220_Handler_t *ADC_Handler)
 void
 ADS1220_ActivateContinuousMode(ADS1220_Handler_t *ADC_Handler)
 {
-  ADS1220_WriteReg(ADC_Handler,REGISTER01h,ADS1220_ReadReg(ADC_Handler,REGISTER01h) | 0x04);
-  PROGRAMLOG("Continuous Mode is %s\r\n",((ADS1220_ReadReg(ADC_Handler,REGISTER01h) >> 2) & 1) ? ("Active") : ("Deactive"));
+  ADS1220_UpdateReg(ADC_Handler, REGISTER01h, ADC_Handler->RegShadow[1] | 0x04);
 }
 
 /**
@@ -401,40 +645,15 @@ ADS1220_ActivateContinuousMode(ADS1220_Handler_t *ADC_Handler)
  * @param  ADCSample:   Pointer Of Samples Array | Number of Element: 2 | [0]: Channel1
  * @param  GainConfig:  Gain Configuration | Number of Element: 2 | [0]: Channel1
  *                      - See ADS1220_GainConfig enum
- * @retval None
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ *                  | ResultWrongMode: ADS1220 is not in Single-shot Mode
  */
-void
+ADS1220_Result_t
 ADS1220_ReadAllSingleShotDiff(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig)
 {
-  uint8_t Reg00hValue = ADS1220_ReadReg(ADC_Handler,REGISTER00h);
-  
-  ADS1220_StartSync(ADC_Handler);          // FOR WAKING UP. if you are using this function consecutively and quickly (less than ~54511.71875 us), you can comment this line
-  while(ADC_Handler->ADC_DRDY_Read());     // FOR WAKING UP. if you are using this function consecutively and quickly (less than ~54511.71875 us), you can comment this line
-
-  if (GainConfig) {  
-    if (((Reg00hValue & 1) | (GainConfig[0] << 1)) != Reg00hValue)  
-      ADS1220_WriteReg(ADC_Handler,REGISTER00h,(Reg00hValue & 1) | (GainConfig[0] << 1));
-    else ADS1220_StartSync(ADC_Handler);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[0]);
-    
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0x50 | (Reg00hValue & 1) | (GainConfig[1] << 1));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[1]);
-  }
-  else
-  { 
-    if ((Reg00hValue & 0x0F) != Reg00hValue)  
-      ADS1220_WriteReg(ADC_Handler,REGISTER00h, (Reg00hValue & 0x0F));
-    else ADS1220_StartSync(ADC_Handler);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[0]);
-    
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0x50 | (Reg00hValue & 0x0F));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[1]);
-  }
-  ADS1220_WriteReg(ADC_Handler,REGISTER00h,Reg00hValue);
+  if (ADC_Handler->RegShadow[1] & 0x04) return ResultWrongMode;
+  if (ADS1220_WakeUp(ADC_Handler) != ResultOK) return ResultTimeout;
+  return ADS1220_ScanBlocking(ADC_Handler, ScanDiff, ADCSample, GainConfig);
 }
 
 /**
@@ -448,31 +667,15 @@ ADS1220_ReadAllSingleShotDiff(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample
  * @param  ADCSample:   Pointer Of Samples Array | Number of Element: 2 | [0]: Channel1
  * @param  GainConfig:  Gain Configuration | Number of Element: 2 | [0]: Channel1
  *                      - See ADS1220_GainConfig enum
- * @retval None
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ *                  | ResultWrongMode: ADS1220 is not in Continuous conversion Mode
  */
-void
+ADS1220_Result_t
 ADS1220_ReadAllContinuousDiff(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig)
 {
-  ADS1220_StartSync(ADC_Handler);          // FOR WAKING UP. if you are using this function consecutively and quickly (less than ~54511.71875 us), you can comment this line
-  while(ADC_Handler->ADC_DRDY_Read());     // FOR WAKING UP. if you are using this function consecutively and quickly (less than ~54511.71875 us), you can comment this line
-  
-  if (GainConfig) {
-    uint8_t Reg00hValue = ADS1220_ReadReg(ADC_Handler,REGISTER00h);
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h,(Reg00hValue & 1) | (GainConfig[0] << 1));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, 0x50 | (Reg00hValue & 1) | (GainConfig[1] << 1), &ADCSample[0]);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, Reg00hValue, &ADCSample[1]);
-  }
-  else
-  {
-    uint8_t Reg00hValue = ADS1220_ReadReg(ADC_Handler,REGISTER00h);
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h,Reg00hValue & 0x0F);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, 0x50 | (Reg00hValue & 0x0F), &ADCSample[0]);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, Reg00hValue, &ADCSample[1]);
-  }
+  if (!(ADC_Handler->RegShadow[1] & 0x04)) return ResultWrongMode;
+  if (ADS1220_WakeUp(ADC_Handler) != ResultOK) return ResultTimeout;
+  return ADS1220_ScanBlocking(ADC_Handler, ScanDiff, ADCSample, GainConfig);
 }
 
 /**
@@ -490,57 +693,15 @@ ADS1220_ReadAllContinuousDiff(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample
  * @param  GainConfig:  Gain Configuration | Number of Element: 4 | [0]: Channel1
  *         @note        Gains must be only 1, 2, and 4. See ADS1220_InputMuxConfig struct for more details.
  *                      - See ADS1220_GainConfig enum
- * @retval None
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ *                  | ResultWrongMode: ADS1220 is not in Single-shot Mode
  */
-void
+ADS1220_Result_t
 ADS1220_ReadAllSingleShotAVSS(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig)
 {
-  uint8_t Reg00hValue = ADS1220_ReadReg(ADC_Handler,REGISTER00h);
-  
-  ADS1220_StartSync(ADC_Handler);          // FOR WAKING UP. if you are using this function consecutively and quickly (less than ~54511.71875 us), you can comment this line
-  while(ADC_Handler->ADC_DRDY_Read());     // FOR WAKING UP. if you are using this function consecutively and quickly (less than ~54511.71875 us), you can comment this line
-  
-  if (GainConfig)
-  { 
-    if ((0x81 | (GainConfig[0] << 1)) != Reg00hValue)
-      ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0x81 | (GainConfig[0] << 1));
-    else ADS1220_StartSync(ADC_Handler);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[0]);
-    
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0x91 | (GainConfig[1] << 1));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[1]);
-    
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0xA1 | (GainConfig[2] << 1));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[2]);
-    
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0xB1 | (GainConfig[3] << 1));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[3]);
-  }
-  else
-  {    
-    if ((0x81 | (Reg00hValue & 0x06)) != Reg00hValue)
-      ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0x81 | (Reg00hValue & 0x06));
-    else ADS1220_StartSync(ADC_Handler);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[0]);
-    
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0x91 | (Reg00hValue & 0x06));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[1]);
-    
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0xA1 | (Reg00hValue & 0x06));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[2]);
-    
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0xB1 | (Reg00hValue & 0x06));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadData(ADC_Handler,&ADCSample[3]);
-  }
-  ADS1220_WriteReg(ADC_Handler,REGISTER00h,Reg00hValue);
+  if (ADC_Handler->RegShadow[1] & 0x04) return ResultWrongMode;
+  if (ADS1220_WakeUp(ADC_Handler) != ResultOK) return ResultTimeout;
+  return ADS1220_ScanBlocking(ADC_Handler, ScanAVSS, ADCSample, GainConfig);
 }
 
 /**
@@ -558,39 +719,1079 @@ ADS1220_ReadAllSingleShotAVSS(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample
  * @param  GainConfig:  Gain Configuration | Number of Element: 4 | [0]: Channel1
  *         @note        Gains must be only 1, 2, and 4. See ADS1220_InputMuxConfig struct for more details.
  *                      - See ADS1220_GainConfig enum
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ *                  | ResultWrongMode: ADS1220 is not in Continuous conversion Mode
+ */
+ADS1220_Result_t
+ADS1220_ReadAllContinuousAVSS(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig)
+{
+  if (!(ADC_Handler->RegShadow[1] & 0x04)) return ResultWrongMode;
+  if (ADS1220_WakeUp(ADC_Handler) != ResultOK) return ResultTimeout;
+  return ADS1220_ScanBlocking(ADC_Handler, ScanAVSS, ADCSample, GainConfig);
+}
+
+/**
+ * @brief  Reads Count registers starting from FirstReg (One burst RREG)
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  FirstReg:    First register to read | 0: REG00h ... 3: REG03h
+ * @param  Count:       Number of registers to read | FirstReg + Count must be <= 4
+ * @param  ReadValues:  Pointer Of Registers Array | Number of Elements: Count | [0]: FirstReg
+ * @retval true:  Registers were read
+ *         false: Invalid range, nothing was sent
+ */
+bool
+ADS1220_ReadRegs(ADS1220_Handler_t *ADC_Handler, uint8_t FirstReg, uint8_t Count, uint8_t *ReadValues)
+{
+  uint8_t TxData[5] = {0};
+  uint8_t RxData[5] = {0};
+  if (!Count || FirstReg + Count > 4) return false;
+  TxData[0] = RREG | (FirstReg << 2) | (Count - 1);
+  ADS1220_Frame(ADC_Handler, TxData, RxData, Count + 1);
+  for (uint8_t i = 0; i < Count; i++) ReadValues[i] = RxData[i + 1];
+  return true;
+}
+
+/**
+ * @brief  Reloads the shadow registers from ADS1220 (One burst RREG)
+ * @note   Use this when the hardware state is suspect (e.g. after a glitch or when another master wrote the registers).
+ * @param  ADC_Handler: Pointer Of Library Handler
  * @retval None
  */
 void
-ADS1220_ReadAllContinuousAVSS(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig)
+ADS1220_SyncShadow(ADS1220_Handler_t *ADC_Handler)
 {
-  uint8_t Reg00hValue = ADS1220_ReadReg(ADC_Handler,REGISTER00h);
-  
-  ADS1220_StartSync(ADC_Handler);          // FOR WAKING UP. if you are using this function consecutively and quickly (less than ~54511.71875 us), you can comment this line
-  while(ADC_Handler->ADC_DRDY_Read());     // FOR WAKING UP. if you are using this function consecutively and quickly (less than ~54511.71875 us), you can comment this line
+  ADS1220_ReadRegs(ADC_Handler, 0, 4, ADC_Handler->RegShadow);
+  PROGRAMLOG("Shadow Regs Values: 0x%02X | 0x%02X | 0x%02X | 0x%02X\r\n",
+    ADC_Handler->RegShadow[0], ADC_Handler->RegShadow[1], ADC_Handler->RegShadow[2], ADC_Handler->RegShadow[3]);
+}
+
+/**
+ * @brief  Verifies the ADS1220 registers against the shadow registers (One burst RREG)
+ * @note   The shadow registers are not changed. Use ADS1220_SyncShadow or ADS1220_ChangeConfig to fix the mismatch.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @retval true:  All registers match the shadow registers
+ *         false: At least one register does not match the shadow registers
+ */
+bool
+ADS1220_VerifyShadow(ADS1220_Handler_t *ADC_Handler)
+{
+  uint8_t RegsValue[4] = {0};
+  ADS1220_ReadRegs(ADC_Handler, 0, 4, RegsValue);
+  for (uint8_t i = 0; i < 4; i++)
+    if (RegsValue[i] != ADC_Handler->RegShadow[i])
+    {
+      PROGRAMLOG("Shadow mismatch on REG%02Xh: 0x%02X (shadow: 0x%02X)\r\n", i, RegsValue[i], ADC_Handler->RegShadow[i]);
+      return false;
+    }
+  return true;
+}
+
+/**
+ * @brief  Initializes a configuration scrubber
+ * @param  Scrub:     Pointer Of Scrubber
+ * @param  Interval:  Check every Interval calls of ADS1220_ScrubTick (e.g. conversions) | 0: Disabled
+ * @param  Period_US: Check when Period_US MicroSeconds passed since the last check (ADC_GetTime_US must be initialized) | 0: Disabled
+ * @retval None
+ */
+void
+ADS1220_ScrubInit(ADS1220_Scrub_t *Scrub, uint16_t Interval, uint32_t Period_US)
+{
+  Scrub->Interval = Interval;
+  Scrub->Period_US = Period_US;
+  Scrub->Count = 0;
+  Scrub->LastCheck_US = 0;
+  Scrub->Checks = 0;
+  Scrub->Repairs = 0;
+}
+
+/**
+ * @brief  Verifies the ADS1220 registers against the shadow registers and repairs them
+ * @note   One burst RREG per check. On a mismatch (e.g. ESD or brown-out) the contiguous range of corrupted registers
+ *         is rewritten in one WREG and, in Continuous conversion mode, the conversions are restarted.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Scrub:       Pointer Of Scrubber
+ * @retval true:  Registers were corrupted and repaired (Scrub->Repairs is incremented)
+ *         false: All registers match the shadow registers
+ */
+bool
+ADS1220_ScrubCheck(ADS1220_Handler_t *ADC_Handler, ADS1220_Scrub_t *Scrub)
+{
+  uint8_t RegsValue[4] = {0};
+  uint8_t First = 4, Last = 0;
   
-  if (GainConfig)
-  {
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0x81 | (GainConfig[0] << 1));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, 0x91 | (GainConfig[1] << 1), &ADCSample[0]);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, 0xA1 | (GainConfig[2] << 1), &ADCSample[1]);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, 0xB1 | (GainConfig[3] << 1), &ADCSample[2]);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, Reg00hValue, &ADCSample[3]);
-  }
-  else
+  Scrub->Count = 0;
+  Scrub->LastCheck_US = ADS1220_TimeUS(ADC_Handler);
+  Scrub->Checks++;
+  ADS1220_ReadRegs(ADC_Handler, 0, 4, RegsValue);
+  for (uint8_t i = 0; i < 4; i++)
   {
-    ADS1220_WriteReg(ADC_Handler,REGISTER00h, 0x81 | (Reg00hValue & 0x06));
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, 0x91 | (Reg00hValue & 0x06), &ADCSample[0]);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, 0xA1 | (Reg00hValue & 0x06), &ADCSample[1]);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, 0xB1 | (Reg00hValue & 0x06), &ADCSample[2]);
-    while(ADC_Handler->ADC_DRDY_Read());
-    ADS1220_ReadDataWriteReg(ADC_Handler, REGISTER00h, Reg00hValue, &ADCSample[3]);
+    if (RegsValue[i] == ADC_Handler->RegShadow[i]) continue;
+    if (First == 4) First = i;
+    Last = i;
   }
+  if (First == 4) return false;
+  
+  PROGRAMLOG("Scrub repair REG%02Xh - REG%02Xh\r\n", First, Last);
+  ADS1220_WriteRegs(ADC_Handler, (ADS1220Register_t)First, Last - First + 1, &ADC_Handler->RegShadow[First]);
+  if (ADC_Handler->PowerState == StateContinuous) ADS1220_StartSync(ADC_Handler); // A brown-out reset also stops the conversions
+  Scrub->Repairs++;
+  return true;
+}
+
+/**
+ * @brief  Runs ADS1220_ScrubCheck when it is due
+ * @note   Call this after every conversion (Interval) and/or from a timer (Period_US).
+ *         If Scrub is initialized in ADC_Handler, ADS1220_OnDRDY calls this after every sample.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Scrub:       Pointer Of Scrubber
+ * @retval true:  A check was done and registers were repaired
+ *         false: No check was due or all registers matched
+ */
+bool
+ADS1220_ScrubTick(ADS1220_Handler_t *ADC_Handler, ADS1220_Scrub_t *Scrub)
+{
+  bool Due = false;
+  if (Scrub->Interval && ++Scrub->Count >= Scrub->Interval) Due = true;
+  if (Scrub->Period_US && ADC_Handler->ADC_GetTime_US &&
+      (uint32_t)(ADS1220_TimeUS(ADC_Handler) - Scrub->LastCheck_US) >= Scrub->Period_US) Due = true;
+  return Due ? ADS1220_ScrubCheck(ADC_Handler, Scrub) : false;
+}
+
+/**
+ * @brief  Writes a register image (Only the registers that differ from the shadow registers, in one WREG)
+ * @note   Writing a register restarts the running conversion.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Image:       REG00h - REG03h values | Number of Elements: 4 | [0]: REG00h
+ * @retval true:  Registers were written
+ *         false: Image equals the current configuration, nothing was sent
+ */
+bool
+ADS1220_WriteImage(ADS1220_Handler_t *ADC_Handler, const uint8_t *Image)
+{
+  return ADS1220_ApplyImage(ADC_Handler, Image, NULL);
+}
+
+/**
+ * @brief  Reads Data and writes a register image in the same frame
+ * @note   Call This function when DRDY pin got LOW. Only the registers that differ from the shadow registers are written.
+ *         One frame in Continuous conversion mode with ADC_Transfer or ADC_TransmitReceive. Otherwise Data is read
+ *         first and the registers are written in a second frame.
+ *         In Single-shot mode the next conversion still needs ADS1220_StartSync.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Image:       REG00h - REG03h values | Number of Elements: 4 | [0]: REG00h
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Elements: 1
+ * @retval true:  Registers were written
+ *         false: Image equals the current configuration, only the data was read
+ */
+bool
+ADS1220_ReadDataWriteImage(ADS1220_Handler_t *ADC_Handler, const uint8_t *Image, int32_t *ADCSample)
+{
+  return ADS1220_ApplyImage(ADC_Handler, Image, ADCSample);
+}
+
+/**
+ * @brief  Checks the DRDY pin
+ * @note   ADC_DRDY_Read or ADC_DRDY_Get must be initialized (or ADC_MISO_Get with DRDYMode = 1).
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @retval true:  New data is ready (DRDY is LOW)
+ *         false: Conversion is in progress
+ */
+bool
+ADS1220_IsDataReady(ADS1220_Handler_t *ADC_Handler)
+{
+  uint8_t Level;
+  if (!ADS1220_UseDOUT(ADC_Handler)) return !ADS1220_DRDYRead(ADC_Handler);
+  ADS1220_Select(ADC_Handler);
+  Level = ADC_Handler->ADC_MISO_Get(ADC_Handler->Context);
+  ADS1220_Deselect(ADC_Handler);
+  return !Level;
+}
+
+/**
+ * @brief  Device state tracked by the library
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @retval See ADS1220_PowerState enum
+ */
+ADS1220_PowerState_t
+ADS1220_GetPowerState(ADS1220_Handler_t *ADC_Handler)
+{
+  return ADC_Handler->PowerState;
 }
 
+/**
+ ** ==================================================================================
+ **                         ##### Bus Scheduler Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes a Bus Scheduler for several ADS1220s sharing one SPI bus
+ * @note   Each device must be initialized by ADS1220_Init before ADS1220_BusStart.
+ * @param  Bus:         Pointer Of Bus Scheduler
+ * @param  Devices:     Pointer Of Handlers Array | Number of Elements: Count
+ * @param  Count:       Number of Devices (1 - 32)
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Elements: Count | [0]: Devices[0]
+ * @retval None
+ */
+void
+ADS1220_BusInit(ADS1220_Bus_t *Bus, ADS1220_Handler_t **Devices, uint8_t Count, int32_t *ADCSample)
+{
+  if (!Bus) return;
+  Bus->Devices = Devices;
+  Bus->Count = (Count > 32) ? 32 : Count;
+  Bus->Samples = ADCSample;
+  Bus->ReadyMask = 0;
+  Bus->SampleCounter = 0;
+  Bus->OnSample = NULL;
+  Bus->UserData = NULL;
+}
+
+/**
+ * @brief  Starts conversion on all devices of the bus
+ * @note   Devices in Single-shot mode are restarted by ADS1220_BusPoll as soon as their data is read.
+ * @param  Bus:         Pointer Of Bus Scheduler
+ * @retval None
+ */
+void
+ADS1220_BusStart(ADS1220_Bus_t *Bus)
+{
+  Bus->ReadyMask = 0;
+  for (uint8_t i = 0; i < Bus->Count; i++)
+    ADS1220_StartSync(Bus->Devices[i]);
+}
+
+/**
+ * @brief  Reads every device whose DRDY is LOW (One pass, Non-blocking)
+ * @note   A device in Single-shot mode is restarted right after its read, so it converts while the
+ *         other devices are read or reconfigured. Call this from the main loop or a timer.
+ *         DRDY is checked by ADS1220_IsDataReady, so devices without DRDY pin (DOUT/DRDY) are supported.
+ * @param  Bus:         Pointer Of Bus Scheduler
+ * @retval Number of samples read in this pass
+ */
+uint8_t
+ADS1220_BusPoll(ADS1220_Bus_t *Bus)
+{
+  uint8_t Read = 0;
+  for (uint8_t i = 0; i < Bus->Count; i++)
+  {
+    ADS1220_Handler_t *ADC_Handler = Bus->Devices[i];
+    if (!ADS1220_IsDataReady(ADC_Handler)) continue;
+    ADS1220_ReadData(ADC_Handler, &Bus->Samples[i]);
+    if (!(ADC_Handler->RegShadow[1] & 0x04)) ADS1220_StartSync(ADC_Handler); // Single-shot mode
+    Bus->ReadyMask |= (1UL << i);
+    Bus->SampleCounter++;
+    Read++;
+    if (Bus->OnSample) Bus->OnSample(Bus, i, Bus->Samples[i]);
+  }
+  return Read;
+}
+
+/**
+ * @brief  Reads one new sample from every device of the bus
+ * @note   Conversions of all devices run in parallel, so this takes about one conversion period
+ *         regardless of the number of devices. Devices[0] provides the time base (ADC_GetTime_US or ADC_Delay_US).
+ *         An empty bus (Count = 0) returns ResultOK at once.
+ * @param  Bus:         Pointer Of Bus Scheduler
+ * @retval ResultOK | ResultTimeout: A device did not have data within ADS1220_DRDY_TIMEOUT_PERCENT of the
+ *                                   longest expected conversion time (Samples of the other devices are valid, See ReadyMask)
+ */
+ADS1220_Result_t
+ADS1220_BusReadAll(ADS1220_Bus_t *Bus)
+{
+  uint32_t AllMask = (Bus->Count >= 32) ? 0xFFFFFFFFUL : ((1UL << Bus->Count) - 1);
+  ADS1220_Handler_t *ADC_Handler;
+  uint32_t Timeout_US = 0, Waited = 0, Start;
+  
+  if (!Bus->Count) return ResultOK; // Empty bus: Nothing to read and no time base
+  ADC_Handler = Bus->Devices[0]; // Time base of the bus
+  for (uint8_t i = 0; i < Bus->Count; i++)
+  {
+    uint32_t Expected_US = ADS1220_ConversionUS(Bus->Devices[i], true);
+    if (Expected_US > Timeout_US) Timeout_US = Expected_US;
+  }
+  Timeout_US = (uint32_t)((uint64_t)Timeout_US * ADS1220_DRDY_TIMEOUT_PERCENT / 100) + ADS1220_DRDY_POLL_US;
+  
+  ADS1220_BusStart(Bus);
+  Start = ADS1220_TimeUS(ADC_Handler);
+  while ((Bus->ReadyMask & AllMask) != AllMask)
+  {
+    if (ADS1220_BusPoll(Bus)) continue;
+    if (ADC_Handler->ADC_GetTime_US) Waited = ADS1220_TimeUS(ADC_Handler) - Start;
+    else
+    {
+      ADS1220_Delay_US(ADS1220_DRDY_POLL_US);
+      Waited += ADS1220_DRDY_POLL_US;
+    }
+    if (Waited > Timeout_US) return ResultTimeout;
+  }
+  return ResultOK;
+}
+
+/**
+ ** ==================================================================================
+ **                            ##### Scan Functions #####                               
+ ** ==================================================================================
+ **/
+
+static void
+ADS1220_ScanBegin (ADS1220_Handler_t *ADC_Handler, ADS1220_Scan_t *Scan, uint8_t (*Image)[4], uint8_t Count,
+                   int32_t *ADCSample, ADS1220_ScanCallback_t Callback)
+{
+  for (uint8_t i = 0; i < 4; i++) Scan->Restore[i] = ADC_Handler->RegShadow[i];
+  Scan->Image = Image;
+  Scan->Count = Count;
+  Scan->Samples = ADCSample;
+  Scan->Callback = Callback;
+  Scan->Index = 0;
+  Scan->Busy = true;
+  ADC_Handler->Scan = Scan;
+  
+  // A WREG restarts a running Continuous conversion; Otherwise one START/SYNC is needed
+  if (!ADS1220_ApplyImage(ADC_Handler, Image[0], NULL) || ADC_Handler->PowerState != StateContinuous)
+    ADS1220_StartSync(ADC_Handler);
+}
+
+/**
+ * @brief  Starts a Non-blocking scan of all channels
+ * @note   Call ADS1220_OnDRDY from the DRDY falling edge interrupt. The scan advances one channel per DRDY
+ *         with no busy-waiting and calls Callback when all channels are read.
+ *         In Continuous conversion mode the next channel is written in the same frame that reads the
+ *         previous one (With ADC_Transfer or ADC_TransmitReceive). In Single-shot mode the read, the WREG
+ *         and the START/SYNC are separate frames.
+ *         Pass GainConfig as NULL to use current values for gain configurations.
+ *         At the end, configurations will be changed to previous values.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Scan:        Pointer Of Scan State | Must stay valid until the scan is done
+ * @param  ScanType:    Channels to scan
+ *                      - ScanDiff: Channel1: AIN0 - AIN1 | Channel2: AIN2 - AIN3
+ *                      - ScanAVSS: Channel1 - Channel4: AIN0 - AIN3 to AVSS (PGA disabled, Gains must be only 1, 2, and 4)
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Element: 2 (ScanDiff) or 4 (ScanAVSS) | [0]: Channel1 | Can be NULL if Ring is initialized
+ * @param  GainConfig:  Gain Configuration | Number of Element: 2 (ScanDiff) or 4 (ScanAVSS) | [0]: Channel1
+ *                      - See ADS1220_GainConfig enum
+ * @param  Callback:    Called (from ADS1220_OnDRDY) when all channels are read | Can be NULL
+ * @retval None
+ */
+void
+ADS1220_ScanStart(ADS1220_Handler_t *ADC_Handler, ADS1220_Scan_t *Scan, ADS1220_ScanType_t ScanType,
+                  int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig, ADS1220_ScanCallback_t Callback)
+{
+  uint8_t Reg00hValue = ADC_Handler->RegShadow[0];
+  uint8_t Count = (ScanType == ScanDiff) ? 2 : 4;
+  
+  for (uint8_t i = 0; i < Count; i++)
+  {
+    for (uint8_t j = 1; j < 4; j++) Scan->Local[i][j] = ADC_Handler->RegShadow[j];
+    if (ScanType == ScanDiff)
+      Scan->Local[i][0] = (i ? 0x50 : 0x00) | (GainConfig ? ((Reg00hValue & 1) | (GainConfig[i] << 1)) : (Reg00hValue & 0x0F));
+    else
+      Scan->Local[i][0] = (0x81 + (i << 4)) | (GainConfig ? (GainConfig[i] << 1) : (Reg00hValue & 0x06));
+  }
+  ADS1220_ScanBegin(ADC_Handler, Scan, Scan->Local, Count, ADCSample, Callback);
+}
+
+/**
+ * @brief  Advances the active scan by one channel
+ * @note   Call this from the DRDY falling edge interrupt (or when DRDY got LOW).
+ *         If Ring is initialized in ADC_Handler, every sample is also pushed to it. Without an active scan
+ *         the current channel is read and pushed to Ring (Channel: 0), or nothing is done if Ring is NULL.
+ *         If Scrub is initialized in ADC_Handler, ADS1220_ScrubTick is called after every sample.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @retval None
+ */
+void
+ADS1220_OnDRDY(ADS1220_Handler_t *ADC_Handler)
+{
+  ADS1220_Scan_t *Scan = ADC_Handler->Scan;
+  ADS1220_Record_t Record;
+  Record.Timestamp = ADS1220_TimeUS(ADC_Handler);
+  Record.Mux = ADC_Handler->RegShadow[0] >> 4;
+  Record.Gain = (ADC_Handler->RegShadow[0] >> 1) & 0x07;
+  
+  if (!Scan || !Scan->Busy)
+  {
+    if (!ADC_Handler->Ring) return;
+    ADS1220_ReadData(ADC_Handler, &Record.Sample);
+    Record.Channel = 0;
+    ADS1220_RingPush(ADC_Handler->Ring, &Record);
+    if (ADC_Handler->Scrub) ADS1220_ScrubTick(ADC_Handler, ADC_Handler->Scrub);
+    return;
+  }
+  
+  uint8_t Index = Scan->Index;
+  bool Last = (Index + 1 >= Scan->Count);
+  
+  ADS1220_ApplyImage(ADC_Handler, Last ? Scan->Restore : Scan->Image[Index + 1], &Record.Sample);
+  if (Scan->Samples) Scan->Samples[Index] = Record.Sample;
+  Scan->Index = Index + 1;
+  if (ADC_Handler->Ring)
+  {
+    Record.Channel = Index;
+    ADS1220_RingPush(ADC_Handler->Ring, &Record);
+  }
+  
+  if (Last)
+  {
+    ADC_Handler->Scan = NULL;
+    Scan->Busy = false;
+    if (Scan->Callback) Scan->Callback(ADC_Handler, Scan->Samples, Scan->Count);
+  }
+  if (ADC_Handler->Scrub) ADS1220_ScrubTick(ADC_Handler, ADC_Handler->Scrub);
+  if (!Last && !(ADC_Handler->RegShadow[1] & 0x04)) ADS1220_StartSync(ADC_Handler); // Single-shot mode
+}
+
+/**
+ * @brief  Precomputes the register images of a channel sequence
+ * @note   REG01h and the settings that are not overridden are taken from the current configuration,
+ *         so call this after ADS1220_Init or ADS1220_ChangeConfig.
+ *         For settings where AINN = AVSS, the PGA is disabled automatically.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Sequence:    Pointer Of Sequence
+ * @param  Entries:     Pointer Of Entries Array | Number of Elements: Count | [0]: Channel1
+ * @param  Count:       Number of Entries (1 - ADS1220_SEQUENCE_MAX)
+ * @retval true:  Sequence is ready
+ *         false: Count is out of range or an AINN = AVSS entry uses a gain higher than 4
+ */
+bool
+ADS1220_SequenceInit(ADS1220_Handler_t *ADC_Handler, ADS1220_Sequence_t *Sequence, const ADS1220_SequenceEntry_t *Entries, uint8_t Count)
+{
+  if (!Sequence || !Entries || !Count || Count > ADS1220_SEQUENCE_MAX) return false;
+  
+  for (uint8_t i = 0; i < Count; i++)
+  {
+    const ADS1220_SequenceEntry_t *Entry = &Entries[i];
+    uint8_t *Image = Sequence->Image[i];
+    bool AVSS = (Entry->InputMuxConfig >= P0NAVSS) && (Entry->InputMuxConfig <= P3NAVSS);
+    
+    if (AVSS && Entry->GainConfig > _4_) return false;
+    for (uint8_t j = 0; j < 4; j++) Image[j] = ADC_Handler->RegShadow[j];
+    Image[0] = (Entry->InputMuxConfig << 4) | (Entry->GainConfig << 1) | (AVSS | Entry->PGAdisable);
+    if (Entry->OverrideVREF)
+      Image[2] = (Image[2] & 0x3F) | (Entry->VoltageRef << 6);
+    if (Entry->OverrideIDAC)
+    {
+      Image[2] = (Image[2] & 0xF8) | Entry->IDACcurrent;
+      Image[3] = (Image[3] & 0x03) | (Entry->IDAC1routing << 5) | (Entry->IDAC2routing << 2);
+    }
+  }
+  Sequence->Count = Count;
+  return true;
+}
+
+/**
+ * @brief  Starts a Non-blocking scan of a channel sequence
+ * @note   Works the same as ADS1220_ScanStart. Only the registers that differ from the previous
+ *         channel are written, in one WREG frame.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Scan:        Pointer Of Scan State | Must stay valid until the scan is done
+ * @param  Sequence:    Pointer Of Sequence initialized by ADS1220_SequenceInit
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Element: Sequence->Count | [0]: Channel1 | Can be NULL if Ring is initialized
+ * @param  Callback:    Called (from ADS1220_OnDRDY) when all channels are read | Can be NULL
+ * @retval None
+ */
+void
+ADS1220_ScanSequenceStart(ADS1220_Handler_t *ADC_Handler, ADS1220_Scan_t *Scan, ADS1220_Sequence_t *Sequence,
+                          int32_t *ADCSample, ADS1220_ScanCallback_t Callback)
+{
+  for (uint8_t i = 0; i < Sequence->Count; i++) Sequence->Image[i][1] = ADC_Handler->RegShadow[1]; // Follow the current operating mode
+  ADS1220_ScanBegin(ADC_Handler, Scan, Sequence->Image, Sequence->Count, ADCSample, Callback);
+}
+
+/**
+ * @brief  Reads all channels of a channel sequence (Blocking)
+ * @note   ADC_DRDY_Read or ADC_DRDY_Get must be initialized.
+ *         At the end, configurations will be changed to previous values.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Sequence:    Pointer Of Sequence initialized by ADS1220_SequenceInit
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Element: Sequence->Count | [0]: Channel1
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ */
+ADS1220_Result_t
+ADS1220_ReadSequence(ADS1220_Handler_t *ADC_Handler, ADS1220_Sequence_t *Sequence, int32_t *ADCSample)
+{
+  ADS1220_Scan_t Scan;
+  ADS1220_ScanSequenceStart(ADC_Handler, &Scan, Sequence, ADCSample, NULL);
+  return ADS1220_ScanWait(ADC_Handler, &Scan);
+}
+
+/**
+ ** ==================================================================================
+ **                         ##### Ring Buffer Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes a Single-producer/Single-consumer lock-free sample ring buffer
+ * @param  Ring:        Pointer Of Ring Buffer
+ * @param  Buffer:      Pointer Of Records Array | Number of Elements: Size
+ * @param  Size:        Number of Records | Must be a power of two (2 - 32768)
+ * @retval true:  Ring buffer is ready
+ *         false: Size is not a power of two
+ */
+bool
+ADS1220_RingInit(ADS1220_Ring_t *Ring, ADS1220_Record_t *Buffer, uint16_t Size)
+{
+  if (!Ring || !Buffer || Size < 2 || (Size & (Size - 1))) return false;
+  Ring->Buffer = Buffer;
+  Ring->Size = Size;
+  Ring->Head = 0;
+  Ring->Tail = 0;
+  Ring->HighWater = 0;
+  Ring->Dropped = 0;
+  return true;
+}
+
+/**
+ * @brief  Pushes one record (Producer side, e.g. DRDY interrupt)
+ * @note   If the ring buffer is full, the record is dropped and Dropped is incremented.
+ * @param  Ring:        Pointer Of Ring Buffer
+ * @param  Record:      Pointer Of Record
+ * @retval true:  Record is stored
+ *         false: Ring buffer is full
+ */
+bool
+ADS1220_RingPush(ADS1220_Ring_t *Ring, const ADS1220_Record_t *Record)
+{
+  uint16_t Head = Ring->Head;
+  uint16_t Used = (uint16_t)(Head - Ring->Tail);
+  if (Used >= Ring->Size)
+  {
+    Ring->Dropped++;
+    return false;
+  }
+  Ring->Buffer[Head & (Ring->Size - 1)] = *Record;
+  ADS1220_MEMORY_BARRIER(); // Record must be visible before Head
+  Ring->Head = Head + 1;
+  if (Used + 1 > Ring->HighWater) Ring->HighWater = Used + 1;
+  return true;
+}
+
+/**
+ * @brief  Pops up to MaxCount records (Consumer side, e.g. processing task)
+ * @param  Ring:        Pointer Of Ring Buffer
+ * @param  Records:     Pointer Of Records Array | Number of Elements: MaxCount
+ * @param  MaxCount:    Maximum number of records to pop
+ * @retval Number of popped records
+ */
+uint16_t
+ADS1220_RingPop(ADS1220_Ring_t *Ring, ADS1220_Record_t *Records, uint16_t MaxCount)
+{
+  uint16_t Tail = Ring->Tail;
+  uint16_t Count = (uint16_t)(Ring->Head - Tail);
+  ADS1220_MEMORY_BARRIER(); // Records must be read after Head
+  if (Count > MaxCount) Count = MaxCount;
+  for (uint16_t i = 0; i < Count; i++)
+    Records[i] = Ring->Buffer[(uint16_t)(Tail + i) & (Ring->Size - 1)];
+  ADS1220_MEMORY_BARRIER(); // Records must be copied before Tail frees them
+  Ring->Tail = Tail + Count;
+  return Count;
+}
+
+/**
+ * @brief  Number of records waiting in the ring buffer
+ * @param  Ring:        Pointer Of Ring Buffer
+ * @retval Number of records
+ */
+uint16_t
+ADS1220_RingCount(ADS1220_Ring_t *Ring)
+{
+  return (uint16_t)(Ring->Head - Ring->Tail);
+}
+
+/**
+ ** ==================================================================================
+ **                         ##### Command Stream Functions #####                               
+ ** ==================================================================================
+ **/
+
+static void
+ADS1220_StreamEmit (ADS1220_Stream_t *Stream, const uint8_t *TxData, uint8_t Length, uint8_t Flags)
+{
+  ADS1220_StreamFrame_t *Frame = &Stream->Frames[Stream->FrameCount++];
+  Frame->Offset = Stream->Length;
+  Frame->Length = Length;
+  Frame->Flags = Flags;
+  for (uint8_t i = 0; i < Length; i++) Stream->TxData[Stream->Length++] = TxData[i];
+}
+
+// Same as ADS1220_ApplyImage, but emits the frame instead of sending it
+static bool
+ADS1220_StreamApplyImage (ADS1220_Stream_t *Stream, uint8_t *Current, const uint8_t *Image, bool ReadData, uint8_t Flags)
+{
+  uint8_t TxData[6] = {0};
+  int8_t First = -1, Last = -1;
+  for (int8_t i = 0; i < 4; i++)
+    if (Image[i] != Current[i])
+    {
+      if (First < 0) First = i;
+      Last = i;
+    }
+  if (First < 0)
+  {
+    if (ReadData) ADS1220_StreamEmit(Stream, TxData, 3, Flags);
+    return false;
+  }
+  uint8_t Count = Last - First + 1;
+  uint8_t Start = ReadData ? 1 : 0;
+  TxData[Start] = WREG | (First << 2) | (Count - 1);
+  for (uint8_t i = 0; i < Count; i++) TxData[Start + 1 + i] = Current[First + i] = Image[First + i];
+  ADS1220_StreamEmit(Stream, TxData, Start + 1 + Count, Flags);
+  return true;
+}
+
+/**
+ * @brief  Compiles one scan cycle of a channel sequence into a flat SPI command stream
+ * @note   The stream holds every frame (WREG, START/SYNC and data read) of the scan in one contiguous
+ *         TX buffer. Each frame is one CS LOW period. Frames with ADS1220_STREAM_WAIT_DRDY must wait for
+ *         DRDY before they are sent. The RX layout of each sample is in SampleOffset.
+ *         In Continuous conversion mode with ADC_Transfer or ADC_TransmitReceive the WREG of the next entry
+ *         is pipelined with the data read; Otherwise the read, the WREG and the START/SYNC are separate frames.
+ *         The stream starts from the current registers and mode, so it must be recompiled after
+ *         ADS1220_ChangeConfig. At the end, configurations are changed to the values before the stream.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Stream:      Pointer Of Command Stream
+ * @param  Sequence:    Pointer Of Sequence initialized by ADS1220_SequenceInit
+ * @retval None
+ */
+void
+ADS1220_StreamCompile(ADS1220_Handler_t *ADC_Handler, ADS1220_Stream_t *Stream, ADS1220_Sequence_t *Sequence)
+{
+  const uint8_t StartSync = START_SYNC;
+  const uint8_t ReadData[3] = {0};
+  bool SingleShot = !(ADC_Handler->RegShadow[1] & 0x04);
+  bool Pipelined = !SingleShot && (ADC_Handler->ADC_Transfer || ADC_Handler->ADC_TransmitReceive); // Same rule as ADS1220_ReadDataWriteRegs
+  uint8_t Current[4];
+  
+  for (uint8_t i = 0; i < 4; i++) Current[i] = Stream->Final[i] = ADC_Handler->RegShadow[i];
+  for (uint8_t i = 0; i < Sequence->Count; i++) Sequence->Image[i][1] = ADC_Handler->RegShadow[1]; // Follow the current operating mode
+  Stream->Length = 0;
+  Stream->FrameCount = 0;
+  Stream->SampleCount = Sequence->Count;
+  
+  // A WREG restarts a running Continuous conversion; Otherwise one START/SYNC is needed (Same as ADS1220_ScanBegin)
+  if (!ADS1220_StreamApplyImage(Stream, Current, Sequence->Image[0], false, 0) || ADC_Handler->PowerState != StateContinuous)
+    ADS1220_StreamEmit(Stream, &StartSync, 1, 0);
+  
+  for (uint8_t i = 0; i < Sequence->Count; i++)
+  {
+    bool Last = (i + 1 >= Sequence->Count);
+    const uint8_t *Next = Last ? Stream->Final : Sequence->Image[i + 1];
+    Stream->SampleOffset[i] = Stream->Length;
+    if (Pipelined)
+      ADS1220_StreamApplyImage(Stream, Current, Next, true, ADS1220_STREAM_WAIT_DRDY);
+    else
+    {
+      ADS1220_StreamEmit(Stream, ReadData, 3, ADS1220_STREAM_WAIT_DRDY);
+      ADS1220_StreamApplyImage(Stream, Current, Next, false, 0);
+    }
+    if (!Last && SingleShot) ADS1220_StreamEmit(Stream, &StartSync, 1, 0);
+  }
+}
+
+/**
+ * @brief  Runs a compiled command stream (Blocking)
+ * @note   Each frame is sent in one CS LOW period. ADC_DRDY_Read or ADC_DRDY_Get must be initialized.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Stream:      Pointer Of Command Stream compiled by ADS1220_StreamCompile
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Element: Stream->SampleCount | [0]: Channel1
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The registers before the stream are written back)
+ */
+ADS1220_Result_t
+ADS1220_StreamRun(ADS1220_Handler_t *ADC_Handler, ADS1220_Stream_t *Stream, int32_t *ADCSample)
+{
+  for (uint8_t i = 0; i < Stream->FrameCount; i++)
+  {
+    const ADS1220_StreamFrame_t *Frame = &Stream->Frames[i];
+    if ((Frame->Flags & ADS1220_STREAM_WAIT_DRDY) &&
+        ADS1220_WaitDRDY(ADC_Handler, ADS1220_ConversionUS(ADC_Handler, true)) != ResultOK)
+    {
+      // The frames sent so far are not in the shadow registers, so all of them are written
+      ADS1220_WriteRegs(ADC_Handler, REGISTER00h, 4, Stream->Final);
+      return ResultTimeout;
+    }
+    ADS1220_Frame(ADC_Handler, &Stream->TxData[Frame->Offset], &Stream->RxData[Frame->Offset], Frame->Length);
+  }
+  ADS1220_StreamDecode(ADC_Handler, Stream, ADCSample);
+  return ResultOK;
+}
+
+/**
+ * @brief  Decodes the samples of a command stream from its RX buffer
+ * @note   Use this after sending the stream by your own DMA engine (RX bytes must be in Stream->RxData).
+ *         The shadow registers are updated to the state at the end of the stream.
+ * @param  ADC_Handler: Pointer Of Library Handler | Can be NULL to only decode
+ * @param  Stream:      Pointer Of Command Stream
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Element: Stream->SampleCount | [0]: Channel1
+ * @retval None
+ */
+void
+ADS1220_StreamDecode(ADS1220_Handler_t *ADC_Handler, const ADS1220_Stream_t *Stream, int32_t *ADCSample)
+{
+  for (uint8_t i = 0; i < Stream->SampleCount; i++)
+    ADCSample[i] = ADS1220_RawToAdcValue(&Stream->RxData[Stream->SampleOffset[i]]);
+  if (ADC_Handler)
+  {
+    for (uint8_t i = 0; i < 4; i++) ADC_Handler->RegShadow[i] = Stream->Final[i];
+    ADC_Handler->PowerState = (Stream->Final[1] & 0x04) ? StateContinuous : StateIdle;
+    ADC_Handler->LastConversion_US = ADS1220_TimeUS(ADC_Handler);
+  }
+}
+
+/**
+ ** ==================================================================================
+ **                         ##### Oversampling Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Resets running statistics
+ * @param  Stats:       Pointer Of Statistics
+ * @retval None
+ */
+void
+ADS1220_StatsReset(ADS1220_Stats_t *Stats)
+{
+  Stats->Count = 0;
+  Stats->Min = INT32_MAX;
+  Stats->Max = INT32_MIN;
+  Stats->First = 0;
+  Stats->Sum = 0;
+  Stats->SumSq = 0;
+}
+
+/**
+ * @brief  Adds one sample to running statistics
+ * @note   Integer only (One 32x32 -> 64 bit multiply), no rounding.
+ * @param  Stats:       Pointer Of Statistics
+ * @param  Sample:      ADC value
+ * @retval None
+ */
+void
+ADS1220_StatsUpdate(ADS1220_Stats_t *Stats, int32_t Sample)
+{
+  int32_t Offset;
+  if (!Stats->Count) Stats->First = Sample;
+  Offset = Sample - Stats->First;
+  Stats->Count++;
+  Stats->Sum += Offset;
+  Stats->SumSq += (uint64_t)((int64_t)Offset * Offset);
+  if (Sample < Stats->Min) Stats->Min = Sample;
+  if (Sample > Stats->Max) Stats->Max = Sample;
+}
+
+/**
+ * @brief  Mean of running statistics in ADC codes
+ * @param  Stats:       Pointer Of Statistics
+ * @retval Mean | 0 if there is no sample
+ */
+double
+ADS1220_StatsMean(const ADS1220_Stats_t *Stats)
+{
+  return Stats->Count ? (double)Stats->First + (double)Stats->Sum / (double)Stats->Count : 0.0;
+}
+
+/**
+ * @brief  Sample variance of running statistics in ADC codes^2
+ * @param  Stats:       Pointer Of Statistics
+ * @retval Variance | 0 if less than 2 samples
+ */
+double
+ADS1220_StatsVariance(const ADS1220_Stats_t *Stats)
+{
+  double Sum = (double)Stats->Sum;
+  if (Stats->Count < 2) return 0.0;
+  return ((double)Stats->SumSq - Sum * Sum / (double)Stats->Count) / (double)(Stats->Count - 1);
+}
+
+/**
+ * @brief  Peak-to-peak of running statistics in ADC codes
+ * @param  Stats:       Pointer Of Statistics
+ * @retval Max - Min | 0 if there is no sample
+ */
+int32_t
+ADS1220_StatsPeakToPeak(const ADS1220_Stats_t *Stats)
+{
+  return Stats->Count ? (Stats->Max - Stats->Min) : 0;
+}
+
+/**
+ * @brief  Collects Count conversions of the current channel into running statistics (Blocking)
+ * @note   ADC_DRDY_Read or ADC_DRDY_Get must be initialized.
+ *         Works in both Single-shot and Continuous conversion mode. No sample is stored.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Stats:       Pointer Of Statistics (Reset by this function)
+ * @param  Count:       Number of conversions
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time
+ */
+ADS1220_Result_t
+ADS1220_ReadOversampled(ADS1220_Handler_t *ADC_Handler, ADS1220_Stats_t *Stats, uint16_t Count)
+{
+  bool SingleShot = !(ADC_Handler->RegShadow[1] & 0x04);
+  int32_t Sample;
+
+  ADS1220_StatsReset(Stats);
+  for (uint16_t i = 0; i < Count; i++)
+  {
+    if (!i || SingleShot) ADS1220_StartSync(ADC_Handler);
+    if (ADS1220_WaitDRDY(ADC_Handler, ADS1220_ConversionUS(ADC_Handler, !i || SingleShot)) != ResultOK) return ResultTimeout;
+    ADS1220_ReadData(ADC_Handler, &Sample);
+    ADS1220_StatsUpdate(Stats, Sample);
+  }
+  return ResultOK;
+}
+
+/**
+ * @brief  Collects Count conversions of each channel of a sequence into running statistics (Blocking)
+ * @note   ADC_DRDY_Read or ADC_DRDY_Get must be initialized.
+ *         Each channel is configured once and converted Count times, so the settling of the first conversion
+ *         is paid once per channel. The last read of a channel and the write of the next one share one frame.
+ *         Use ADS1220_SequenceInit with AIN0-AIN1/AIN2-AIN3 or AINx-AVSS entries for the ReadAll channel sets.
+ *         At the end, configurations will be changed to previous values.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Sequence:    Pointer Of Sequence initialized by ADS1220_SequenceInit
+ * @param  Stats:       Pointer Of Statistics Array | Number of Element: Sequence->Count | [0]: Channel1
+ * @param  Count:       Number of conversions per channel
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ */
+ADS1220_Result_t
+ADS1220_ReadSequenceOversampled(ADS1220_Handler_t *ADC_Handler, ADS1220_Sequence_t *Sequence, ADS1220_Stats_t *Stats, uint16_t Count)
+{
+  bool SingleShot = !(ADC_Handler->RegShadow[1] & 0x04);
+  uint8_t Restore[4];
+  int32_t Sample;
+
+  if (!Count || !Sequence->Count) return ResultOK;
+  for (uint8_t i = 0; i < 4; i++) Restore[i] = ADC_Handler->RegShadow[i];
+  for (uint8_t i = 0; i < Sequence->Count; i++) Sequence->Image[i][1] = ADC_Handler->RegShadow[1]; // Follow the current operating mode
+
+  // A WREG restarts a running Continuous conversion; Otherwise one START/SYNC is needed (Same as ADS1220_ScanBegin)
+  if (!ADS1220_ApplyImage(ADC_Handler, Sequence->Image[0], NULL) || ADC_Handler->PowerState != StateContinuous)
+    ADS1220_StartSync(ADC_Handler);
+  for (uint8_t Channel = 0; Channel < Sequence->Count; Channel++)
+  {
+    bool Last = (Channel + 1 >= Sequence->Count);
+    ADS1220_StatsReset(&Stats[Channel]);
+    for (uint16_t i = 0; i < Count; i++)
+    {
+      if (i && SingleShot) ADS1220_StartSync(ADC_Handler);
+      if (ADS1220_WaitDRDY(ADC_Handler, ADS1220_ConversionUS(ADC_Handler, !i || SingleShot)) != ResultOK)
+      {
+        ADS1220_ApplyImage(ADC_Handler, Restore, NULL);
+        return ResultTimeout;
+      }
+      if (i + 1 < Count) ADS1220_ReadData(ADC_Handler, &Sample);
+      else // Read the last conversion and switch to the next channel in one frame
+      {
+        ADS1220_ApplyImage(ADC_Handler, Last ? Restore : Sequence->Image[Channel + 1], &Sample);
+        if (!Last && SingleShot) ADS1220_StartSync(ADC_Handler);
+      }
+      ADS1220_StatsUpdate(&Stats[Channel], Sample);
+    }
+  }
+  return ResultOK;
+}
+
+/**
+ ** ==================================================================================
+ **                          ##### Auto-range Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes auto-ranging of the channels of a sequence
+ * @note   Each channel starts with the gain of its sequence entry. Gains are limited to 1, 2 and 4 for
+ *         entries with the PGA disabled (AINN = AVSS settings are always PGA disabled).
+ *         Gain goes down when a sample passes (100 - HeadroomPercent)% of full scale, and goes up to the
+ *         highest gain whose predicted sample stays below (100 - HeadroomPercent - HysteresisPercent)% of full scale.
+ * @param  AutoRange:         Pointer Of Auto-range State
+ * @param  Sequence:          Pointer Of Sequence initialized by ADS1220_SequenceInit
+ * @param  HeadroomPercent:   Headroom below full scale (0 - 99), E.g. 10
+ * @param  HysteresisPercent: Extra margin needed to increase gain (0 - 99), E.g. 10
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_AutoRangeInit(ADS1220_AutoRange_t *AutoRange, const ADS1220_Sequence_t *Sequence, uint8_t HeadroomPercent, uint8_t HysteresisPercent)
+{
+  if (!Sequence->Count || Sequence->Count > ADS1220_SEQUENCE_MAX || HeadroomPercent + HysteresisPercent >= 100) return false;
+
+  AutoRange->Count = Sequence->Count;
+  AutoRange->Upper = (int32_t)(0x7FFFFFLL * (100 - HeadroomPercent) / 100);
+  AutoRange->Lower = (int32_t)(0x7FFFFFLL * (100 - HeadroomPercent - HysteresisPercent) / 100);
+  for (uint8_t i = 0; i < Sequence->Count; i++)
+  {
+    AutoRange->MaxGain[i] = (Sequence->Image[i][0] & 0x01) ? _4_ : _128_; // PGA disabled: Gains 1, 2 and 4 only
+    AutoRange->Gain[i] = (Sequence->Image[i][0] >> 1) & 0x07;
+    if (AutoRange->Gain[i] > AutoRange->MaxGain[i]) AutoRange->Gain[i] = AutoRange->MaxGain[i];
+  }
+  return true;
+}
+
+/**
+ * @brief  Writes the current gain of each channel into the register images of a sequence
+ * @note   Call it before ADS1220_ScanSequenceStart or ADS1220_ReadSequence. The gain then goes out in the
+ *         same WREG frame as the input multiplexer of the channel.
+ * @param  AutoRange:   Pointer Of Auto-range State
+ * @param  Sequence:    Pointer Of Sequence
+ * @retval None
+ */
+void
+ADS1220_AutoRangeApply(const ADS1220_AutoRange_t *AutoRange, ADS1220_Sequence_t *Sequence)
+{
+  for (uint8_t i = 0; i < AutoRange->Count; i++)
+    Sequence->Image[i][0] = (Sequence->Image[i][0] & 0xF1) | (AutoRange->Gain[i] << 1);
+}
+
+/**
+ * @brief  Normalises the samples of a sequence to gain 128 and picks the gain of each channel for the next scan
+ * @note   Normalised = ADCSample * 128 / Gain, so values of all channels and gains are comparable
+ *         (ADCValueToVoltage(Normalised, VREF, 128) gives Volt). Full scale is +-2^30.
+ * @param  AutoRange:   Pointer Of Auto-range State
+ * @param  ADCSample:   Pointer Of Samples Array read with the current gains | [0]: Channel1
+ * @param  Normalised:  Pointer Of output Array | Number of Element: Sequence->Count | Can be equal to ADCSample
+ * @retval Bit i is set if the gain of channel i changed
+ */
+uint8_t
+ADS1220_AutoRangeUpdate(ADS1220_AutoRange_t *AutoRange, const int32_t *ADCSample, int32_t *Normalised)
+{
+  uint8_t Changed = 0;
+
+  for (uint8_t i = 0; i < AutoRange->Count; i++)
+  {
+    int32_t Sample = ADCSample[i];
+    uint8_t Gain = AutoRange->Gain[i];
+    int64_t Magnitude = (Sample < 0) ? -(int64_t)Sample : Sample;
+
+    Normalised[i] = Sample * (1 << (_128_ - Gain));
+
+    if (Magnitude > AutoRange->Upper)
+      Gain = (Sample >= 0x7FFFFF || Sample <= -0x800000) ? _1_ : Gain - (Gain > _1_); // Clipped: Value is unknown, restart from gain 1
+    else
+      while (Gain < AutoRange->MaxGain[i] && (Magnitude << (Gain + 1 - AutoRange->Gain[i])) <= AutoRange->Lower) Gain++;
+
+    if (Gain != AutoRange->Gain[i])
+    {
+      AutoRange->Gain[i] = Gain;
+      Changed |= (1 << i);
+    }
+  }
+  return Changed;
+}
+
+/**
+ * @brief  Reads all channels of a sequence with auto-ranged gains (Blocking)
+ * @note   Same as ADS1220_AutoRangeApply, ADS1220_ReadSequence and ADS1220_AutoRangeUpdate.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Sequence:    Pointer Of Sequence
+ * @param  AutoRange:   Pointer Of Auto-range State initialized for Sequence
+ * @param  Normalised:  Pointer Of Samples Array (Normalised to gain 128) | Number of Element: Sequence->Count | [0]: Channel1
+ *                      Not written on timeout
+ * @param  Changed:     Pointer Of gain change mask: Bit i is set if the gain of channel i changed for the next call
+ *                      Can be NULL | Set to 0 on timeout
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (Normalised and the gains are unchanged)
+ */
+ADS1220_Result_t
+ADS1220_ReadSequenceAutoRange(ADS1220_Handler_t *ADC_Handler, ADS1220_Sequence_t *Sequence, ADS1220_AutoRange_t *AutoRange,
+                              int32_t *Normalised, uint8_t *Changed)
+{
+  int32_t ADCSample[ADS1220_SEQUENCE_MAX];
+  uint8_t GainChanged = 0;
+  ADS1220_Result_t Result;
+
+  ADS1220_AutoRangeApply(AutoRange, Sequence);
+  Result = ADS1220_ReadSequence(ADC_Handler, Sequence, ADCSample);
+  if (Result == ResultOK)
+    GainChanged = ADS1220_AutoRangeUpdate(AutoRange, ADCSample, Normalised);
+  if (Changed) *Changed = GainChanged;
+  return Result;
+}
+
+/**
+ ** ==================================================================================
+ **                          ##### Profile Bank Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes an empty profile bank
+ * @param  Bank: Pointer Of Profile Bank
+ * @retval None
+ */
+void
+ADS1220_ProfileBankInit(ADS1220_ProfileBank_t *Bank)
+{
+  Bank->Count = 0;
+}
+
+/**
+ * @brief  Adds a profile and precomputes its register image
+ * @note   Parameters are packed as ADS1220_ChangeConfig does (Nothing is sent to ADS1220).
+ * @param  Bank:       Pointer Of Profile Bank
+ * @param  Name:       Name of the profile (The pointer is kept, so it must stay valid)
+ * @param  Parameters: Pointer Of ADC Parameters | NULL: Default values
+ * @retval Index of the profile | -1: The bank is full (ADS1220_PROFILE_MAX)
+ */
+int8_t
+ADS1220_ProfileAdd(ADS1220_ProfileBank_t *Bank, const char *Name, const ADS1220_Parameters_t *Parameters)
+{
+  if (Bank->Count >= ADS1220_PROFILE_MAX) return -1;
+  ADS1220_PackParameters(Parameters, Bank->Image[Bank->Count]);
+  Bank->Name[Bank->Count] = Name;
+  return Bank->Count++;
+}
+
+/**
+ * @brief  Finds a profile by name
+ * @param  Bank: Pointer Of Profile Bank
+ * @param  Name: Name of the profile
+ * @retval Index of the profile | -1: Not found
+ */
+int8_t
+ADS1220_ProfileFind(const ADS1220_ProfileBank_t *Bank, const char *Name)
+{
+  for (uint8_t i = 0; i < Bank->Count; i++)
+  {
+    const char *A = Bank->Name[i], *B = Name;
+    if (!A || !B) continue;
+    while (*A && *A == *B) A++, B++;
+    if (*A == *B) return i;
+  }
+  return -1;
+}
+
+/**
+ * @brief  Switches to a profile (At most one WREG)
+ * @note   Only the contiguous range of registers that differ from the current configuration is written.
+ *         Writing a register restarts the running conversion. In Single-shot mode the conversion still needs ADS1220_StartSync.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Bank:        Pointer Of Profile Bank
+ * @param  Index:       Index of the profile (See ADS1220_ProfileAdd and ADS1220_ProfileFind)
+ * @retval true:  Registers were written
+ *         false: The profile is already active or Index is invalid, nothing was sent
+ */
+bool
+ADS1220_ProfileSelect(ADS1220_Handler_t *ADC_Handler, const ADS1220_ProfileBank_t *Bank, int8_t Index)
+{
+  if (Index < 0 || Index >= Bank->Count) return false;
+  return ADS1220_ApplyImage(ADC_Handler, Bank->Image[Index], NULL);
+}
+
+/**
+ * @brief  Reads Data and switches to a profile in the same frame
+ * @note   Call This function when DRDY pin got LOW. Same as ADS1220_ReadDataWriteImage with the image of the profile.
+ *         If Index is invalid, only the data is read.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Bank:        Pointer Of Profile Bank
+ * @param  Index:       Index of the profile (See ADS1220_ProfileAdd and ADS1220_ProfileFind)
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Elements: 1
+ * @retval true:  Registers were written
+ *         false: The profile is already active or Index is invalid, only the data was read
+ */
+bool
+ADS1220_ReadDataProfileSelect(ADS1220_Handler_t *ADC_Handler, const ADS1220_ProfileBank_t *Bank, int8_t Index, int32_t *ADCSample)
+{
+  if (Index < 0 || Index >= Bank->Count)
+  {
+    ADS1220_ReadData(ADC_Handler, ADCSample);
+    return false;
+  }
+  return ADS1220_ApplyImage(ADC_Handler, Bank->Image[Index], ADCSample);
+}
@@ -44,17 +44,29 @@ extern "C" {
 // SPI Configuration : 8Bits, CPOL=LOW(0), CPHA=2EDGE(1), Max speed (period): 150ns (6.66MHz)
 #define ADS1220_USE_MACRO_DELAY         0    // 0: Use handler delay ,So you have to set ADC_Delay_US in Handler | 1: use Macro delay, So you have to set ADS1220_MACRO_DELAY_US Macro
 //#define ADS1220_MACRO_DELAY_US(x)            // If you want to use Macro delay, place your delay function in microseconds here
+#define ADS1220_SEQUENCE_MAX            8    // Maximum number of entries of a channel sequence, 8 or less (See ADS1220_SequenceInit)
+#define ADS1220_PROFILE_MAX             8    // Maximum number of profiles of a profile bank (See ADS1220_ProfileAdd)
+#define ADS1220_TIMING_PROFILE          1    // 0: Legacy padded delays (10us around every byte) | 1: Minimum delays derived from datasheet, ADS1220_SPI_CLOCK_HZ and ADS1220_FCLK_HZ (Can be overridden per handler, See Timing in ADS1220_Handler_t)
+#define ADS1220_SPI_CLOCK_HZ            4000000 // SPI clock (SCLK) frequency used for ADS1220_TIMING_PROFILE = 1
+#define ADS1220_FCLK_HZ                 4096000 // ADS1220 clock (fCLK) frequency used for ADS1220_TIMING_PROFILE = 1 and conversion timing | 4.096MHz: Internal oscillator
+#define ADS1220_DRDY_SLEEP_PERCENT      90   // Blocking functions sleep for this percent of the expected conversion time, then poll DRDY
+#define ADS1220_DRDY_TIMEOUT_PERCENT    200  // Blocking functions give up (ResultTimeout) after this percent of the expected conversion time
+#define ADS1220_DRDY_POLL_US            10   // DRDY poll interval when ADC_GetTime_US is not initialized
+#define ADS1220_WAKEUP_IDLE_US          0    // ReadAll functions also do a wake-up conversion after this idle time in Single-shot mode (Needs ADC_GetTime_US) | 0: Only after power up, RESET and POWERDOWN
 //#define ADS1220_Debug_Enable                 // Uncomment if you want to use (depends on printf in stdio.h)
 //#pragma anon_unions                          // Uncomment this line if yu are using Keil software
+//#define ADS1220_MEMORY_BARRIER()             // Uncomment and place your memory barrier here if your compiler is not GCC or Clang (e.g. __DMB())
 //? ------------------------------------------------------------------------------- //
 
 //* Defines and Macros ------------------------------------------------------------ //
+// For parts without FPU, see ADS1220_Fixed.h (ADCValueToFixed)
 #define ADCValueToVoltage(x/*ADCvalue*/, v/*VREFF*/, g/*gain*/) ((float)x * v / (float)0x7FFFFF / g) // Use this to convert ADC value to Voltage - It Works
 #define ADCValueToWeight(x/*ADCvalue*/, mw/*Max Weight*/, s/*Sensitivity*/, g/*gain*/) ((float)x * mw / (float)0x7FFFFF /s /g)
 #define ADCValueToDisplacement(x/*ADCvalue*/, md /*Max Displacement*/) ((float)x * md / (float)0x7FFFFF)
 #define ADCValueToTemperature(x/*ADCvalue*/, t/*Temperature*/) ((float)x * t / (float)0x7FFFFF)
 #define ADCValueToTemperatureRTD(x/*ADCvalue*/, r/*RREF*/, r0/*R0-NOMINAL*/, a/*Alpha-TCR*/, g/*gain*/) (((float)x / (float)0x7FFFFF * 2.0f * r / g / r0 - 1) / a) // TCR(a) = (R100 - R0) / (R0 * 100)
 #define ADCValueToCurrent(x/*ADCvalue*/, r/*Resistance*/, v/*VREFF*/, g/*gain*/) ((float)x / r * v / (float)0x7FFFFF / g)
+#define ADCValueToInternalTemperature(x/*ADCvalue*/) ((float)((x) / 1024) * 0.03125f) // Temperature sensor mode: 14-bit left-justified, 0.03125C per LSB
 
 //! DO NOT USE OR EDIT THIS BLOCK ------------------------------------------------- //
 #if ADS1220_USE_MACRO_DELAY == 0
@@ -66,16 +78,19 @@ extern "C" {
 #endif
 #endif
 
-typedef union
-ADS1220_OneSample_u {
-  struct {
-    uint32_t Zero :8; // Always Zero
-    uint32_t Part1:8;
-    uint32_t Part2:8;
-    uint32_t Part3:8;
-  };
-  int32_t INT32;
-} ADS1220_OneSample_t;
+#define ADS1220_NS_TO_US(x)   (((x) + 999UL) / 1000UL)
+#if ADS1220_TIMING_PROFILE == 0
+#define ADS1220_TIMING_DEFAULT  {10, 10, 20, 10, 100}
+#elif ADS1220_TIMING_PROFILE == 1
+#define ADS1220_TIMING_DEFAULT  {ADS1220_NS_TO_US(50), ADS1220_NS_TO_US(25), ADS1220_NS_TO_US(20), \
+                                 ADS1220_NS_TO_US(1000000000UL / ADS1220_SPI_CLOCK_HZ), \
+                                 50 + ADS1220_NS_TO_US(32000000000ULL / ADS1220_FCLK_HZ)}
+#else
+#error "ADS1220_TIMING_PROFILE must be 0 or 1"
+#endif
+#if ADS1220_SEQUENCE_MAX > 8
+#error "ADS1220_SEQUENCE_MAX must be 8 or less (Gain change masks of ADS1220_AutoRangeUpdate are 8 bits)"
+#endif
 //! ------------------------------------------------------------------------------- //
 
 /**
@@ -217,26 +232,219 @@ ADS1220_IDACrouting_e {
   REFN0         = 6  // IDAC connected to REFN0
 } ADS1220_IDACrouting_t;
 
+/**
+ * @brief  Channels scanned by ADS1220_ScanStart
+ */
+typedef enum
+ADS1220_ScanType_e {
+  ScanDiff      = 0, // Channel1: AINP = AIN0, AINN = AIN1 | Channel2: AINP = AIN2, AINN = AIN3
+  ScanAVSS      = 1  // Channel1 - Channel4: AINP = AIN0 - AIN3, AINN = AVSS (PGA disabled)
+} ADS1220_ScanType_t;
+
+/**
+ * @brief  Result of blocking functions
+ */
+typedef enum
+ADS1220_Result_e {
+  ResultOK      = 0,
+  ResultTimeout = 1, // DRDY did not go LOW within ADS1220_DRDY_TIMEOUT_PERCENT of the expected conversion time
+  ResultWrongMode = 2 // ADS1220 is not in the conversion mode the function is made for (Nothing was sent)
+} ADS1220_Result_t;
+
+/**
+ * @brief  Device state tracked by the library
+ */
+typedef enum
+ADS1220_PowerState_e {
+  StatePowerDown  = 0, // After power up, RESET or POWERDOWN: The next ReadAll function does a wake-up conversion
+  StateIdle       = 1, // Single-shot mode: Converting or waiting for START/SYNC
+  StateContinuous = 2  // Continuous conversion mode: Converting
+} ADS1220_PowerState_t;
+
 /**
  ** ==================================================================================
  **                               ##### Structs #####                               
  ** ==================================================================================
  **/
 
+/**
+ * @brief  One sample record of the ring buffer
+ */
+typedef struct
+ADS1220_Record_s {
+  int32_t  Sample;                      // ADC value
+  uint32_t Timestamp;                   // ADC_GetTime_US at DRDY (0 if ADC_GetTime_US is not initialized)
+  uint8_t  Channel;                     // Channel index in the scan (0 without scan)
+  uint8_t  Mux;                         // See ADS1220_InputMuxConfig enum
+  uint8_t  Gain;                        // See ADS1220_GainConfig enum
+} ADS1220_Record_t;
+
+/**
+ * @brief  Single-producer/Single-consumer lock-free sample ring buffer
+ * @note   Use ADS1220_RingInit to initialize it. The producer (DRDY interrupt) only writes Head and
+ *         the consumer (task) only writes Tail, so no lock is needed.
+ */
+typedef struct
+ADS1220_Ring_s {
+  ADS1220_Record_t *Buffer;             // Pointer Of Records Array
+  uint16_t Size;                        // Number of Records (power of two)
+  volatile uint16_t Head;               // Written by producer only
+  volatile uint16_t Tail;               // Written by consumer only
+  volatile uint16_t HighWater;          // Maximum number of records that were waiting at once
+  volatile uint32_t Dropped;            // Number of records dropped because the ring buffer was full
+} ADS1220_Ring_t;
+
+/**
+ * @brief  One entry of a channel sequence
+ * @note   For settings where AINN = AVSS, the PGA is disabled automatically and only gains 1, 2, and 4 can be used.
+ */
+typedef struct
+ADS1220_SequenceEntry_s {
+  ADS1220_InputMuxConfig_t InputMuxConfig;  // See ADS1220_InputMuxConfig enum
+  ADS1220_GainConfig_t     GainConfig;      // See ADS1220_GainConfig enum
+  bool                     PGAdisable;      // 0: PGA enabled | 1: PGA disabled and bypassed
+  bool                     OverrideVREF;    // 0: Keep current VoltageRef | 1: Use VoltageRef of this entry
+  ADS1220_VoltageRef_t     VoltageRef;      // See ADS1220_VoltageRef enum
+  bool                     OverrideIDAC;    // 0: Keep current IDAC settings | 1: Use IDAC settings of this entry
+  ADS1220_IDACcurrent_t    IDACcurrent;     // See ADS1220_IDACcurrent enum
+  ADS1220_IDACrouting_t    IDAC1routing;    // See ADS1220_IDACrouting enum
+  ADS1220_IDACrouting_t    IDAC2routing;    // See ADS1220_IDACrouting enum
+} ADS1220_SequenceEntry_t;
+
+/**
+ * @brief  Precomputed channel sequence
+ * @note   Use ADS1220_SequenceInit to initialize it.
+ */
+typedef struct
+ADS1220_Sequence_s {
+  uint8_t Image[ADS1220_SEQUENCE_MAX][4];   // Registers (REG00h - REG03h) of each entry
+  uint8_t Count;                            // Number of entries
+} ADS1220_Sequence_t;
+
+#define ADS1220_STREAM_WAIT_DRDY     0x01                              // Frame must wait for DRDY before it is sent
+#define ADS1220_STREAM_MAX_FRAMES    (2 + 3 * ADS1220_SEQUENCE_MAX)    // WREG + START/SYNC, then (Read + WREG + START/SYNC) per entry
+#define ADS1220_STREAM_MAX_BYTES     (6 + 9 * ADS1220_SEQUENCE_MAX)
+
+/**
+ * @brief  One frame (one CS LOW period) of a command stream
+ */
+typedef struct
+ADS1220_StreamFrame_s {
+  uint16_t Offset;                      // Offset of the frame in TxData and RxData
+  uint8_t  Length;                      // Number of bytes
+  uint8_t  Flags;                       // ADS1220_STREAM_WAIT_DRDY: Wait for DRDY before this frame
+} ADS1220_StreamFrame_t;
+
+/**
+ * @brief  Precompiled SPI command stream of one scan cycle (DMA-ready)
+ * @note   Use ADS1220_StreamCompile to initialize it.
+ */
+typedef struct
+ADS1220_Stream_s {
+  uint8_t  TxData[ADS1220_STREAM_MAX_BYTES];            // All frames back to back
+  uint8_t  RxData[ADS1220_STREAM_MAX_BYTES];            // Received bytes, same layout as TxData
+  ADS1220_StreamFrame_t Frames[ADS1220_STREAM_MAX_FRAMES];
+  uint8_t  FrameCount;                                  // Number of frames
+  uint16_t Length;                                      // Number of bytes of all frames
+  uint16_t SampleOffset[ADS1220_SEQUENCE_MAX];          // RX layout map: Offset of the 3 data bytes of each channel
+  uint8_t  SampleCount;                                 // Number of samples
+  uint8_t  Final[4];                                    // Registers at the end of the stream
+} ADS1220_Stream_t;
+
+/**
+ * @brief  Scan Completion Callback
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  ADCSample:   Pointer Of Samples Array passed to ADS1220_ScanStart | [0]: Channel1
+ * @param  Count:       Number of Samples
+ */
+struct ADS1220_Handler_s;
+typedef void (*ADS1220_ScanCallback_t)(struct ADS1220_Handler_s *ADC_Handler, int32_t *ADCSample, uint8_t Count);
+
+/**
+ * @brief  Scan State
+ * @note   Filled by ADS1220_ScanStart. !!! DO NOT EDIT THIS WHILE Busy IS true !!!
+ */
+typedef struct
+ADS1220_Scan_s {
+  uint8_t  (*Image)[4];                 // Registers (REG00h - REG03h) of each channel
+  uint8_t  Local[4][4];                 // Image storage for ScanDiff and ScanAVSS
+  uint8_t  Restore[4];                  // Registers before the scan
+  uint8_t  Count;                       // Number of channels
+  volatile uint8_t Index;               // Next channel to be read
+  volatile bool Busy;                   // true: Scan is in progress
+  int32_t  *Samples;                    // Pointer Of Samples Array | [0]: Channel1
+  ADS1220_ScanCallback_t Callback;      // Called when all channels are read
+} ADS1220_Scan_t;
+
+/**
+ * @brief  SPI Timing Profile (All values are in MicroSecond)
+ * @note   Use ADS1220_TimingInit to derive the minimum values from the SPI clock and fCLK.
+ *         Delay budget of one frame of N bytes: CSSetup + CSHold + CSHigh (+ (N - 1) * InterByte without ADC_Transfer)
+ */
+typedef struct
+ADS1220_Timing_s {
+  uint16_t CSSetup_US;   // CS falling edge to first SCLK            (td(CSSC) >= 50ns)
+  uint16_t CSHold_US;    // Final SCLK falling edge to CS rising edge (td(SCCS) >= 25ns)
+  uint16_t CSHigh_US;    // CS HIGH time after each command          (tw(CSH) >= 20ns)
+  uint16_t InterByte_US; // Gap between bytes, Only used when ADC_Transfer is not initialized (one SCLK period)
+  uint16_t Reset_US;     // Wait after power up and RESET command    (50us + 32 * tCLK)
+} ADS1220_Timing_t;
+
+/**
+ * @brief  Conversion timing of one configuration (See ADS1220_GetConversionTiming)
+ */
+typedef struct
+ADS1220_ConversionTiming_s {
+  uint32_t Period_US;           // Data period in Continuous conversion mode
+  uint32_t FirstConversion_US;  // START/SYNC (or a register write while converting) to DRDY LOW | Single-shot conversion time
+} ADS1220_ConversionTiming_t;
+
+/**
+ * @brief  Configuration Scrubber (See ADS1220_ScrubInit)
+ */
+typedef struct
+ADS1220_Scrub_s {
+  uint16_t Interval;      // Check every Interval calls of ADS1220_ScrubTick | 0: Disabled
+  uint32_t Period_US;     // Check when Period_US passed since the last check | 0: Disabled
+  uint16_t Count;         // Calls of ADS1220_ScrubTick since the last check
+  uint32_t LastCheck_US;  // ADC_GetTime_US of the last check
+  uint32_t Checks;        // Number of checks (One burst RREG each)
+  uint32_t Repairs;       // Number of checks that found corrupted registers and rewrote them
+} ADS1220_Scrub_t;
+
 /**
  * @brief  Handling Library
  * @note   User MUST configure This at the beginning of the program before ADS1230_Init
  */
 typedef struct
 ADS1220_Handler_s {
-  void (*ADC_CS_HIGH)(void);                     // Must be initialized
-  void (*ADC_CS_LOW)(void);                      // Must be initialized
-  void (*ADC_Transmit)(uint8_t Data);            // Must be initialized
-  uint8_t (*ADC_Receive)(void);                  // Must be initialized
-  uint8_t (*ADC_TransmitReceive)(uint8_t Data);  // Can be initialized - Initialize this when you want to use ReadAllContinuous functions
+  void (*ADC_CS_HIGH)(void);                     // Must be initialized if ADC_CS_Write is not initialized
+  void (*ADC_CS_LOW)(void);                      // Must be initialized if ADC_CS_Write is not initialized
+  void (*ADC_Transmit)(uint8_t Data);            // Must be initialized if ADC_Transfer is not initialized
+  uint8_t (*ADC_Receive)(void);                  // Must be initialized if ADC_Transfer is not initialized
+  uint8_t (*ADC_TransmitReceive)(uint8_t Data);  // Can be initialized - Without ADC_Transfer, initialize this to merge data reads and register writes in one frame
   uint8_t (*ADC_DRDY_Read)(void);                // Can be initialized - Initialize this when you want to use ReadAllContinuous functions
   void (*ADC_Delay_US)(uint32_t);                // Must be initialized (Place here your delay in MicroSecond)
-  ADS1220_OneSample_t ADCDataValues;              //!!! DO NOT USE OR EDIT THIS !!!
+  // Can be initialized (Recommended) - Full-duplex bulk transfer of Length bytes while CS is LOW.
+  // Every command is issued as one call, so the SPI peripheral or DMA can stream at full clock.
+  // TxData is never NULL. RxData is NULL when the received bytes are not needed.
+  // If it is initialized, ADC_Transmit, ADC_Receive and ADC_TransmitReceive are not used.
+  void (*ADC_Transfer)(void *Context, const uint8_t *TxData, uint8_t *RxData, uint16_t Length);
+  void *Context;                                 // Can be initialized - User pointer of this device, passed to ADC_Transfer, ADC_CS_Write and ADC_DRDY_Get as is
+  void (*ADC_CS_Write)(void *Context, uint8_t Level); // Can be initialized - Used instead of ADC_CS_HIGH and ADC_CS_LOW | Level 0: LOW, 1: HIGH
+  uint8_t (*ADC_DRDY_Get)(void *Context);        // Can be initialized - Used instead of ADC_DRDY_Read
+  const ADS1220_Timing_t *Timing;                // Can be initialized - SPI timing profile of this handler | NULL: Use ADS1220_TIMING_PROFILE
+  uint32_t (*ADC_GetTime_US)(void *Context);     // Can be initialized - Free running MicroSecond counter (Used for sample timestamps)
+  ADS1220_Ring_t *Ring;                          // Can be initialized - ADS1220_OnDRDY pushes every sample to this ring buffer
+  void (*ADC_Sleep_US)(void *Context, uint32_t Time_US); // Can be initialized - Sleep or yield (e.g. RTOS delay) while a conversion is running | NULL: ADC_Delay_US is used
+  // Can be initialized - Level of MISO (DOUT/DRDY) while CS is LOW. With DRDYMode = 1 it replaces the DRDY pin
+  // when ADC_DRDY_Read and ADC_DRDY_Get are not initialized (See ADS1220_ReadDataDOUT)
+  uint8_t (*ADC_MISO_Get)(void *Context);
+  ADS1220_Scrub_t *Scrub;                        // Can be initialized - ADS1220_OnDRDY runs ADS1220_ScrubTick after every sample
+  uint8_t RegShadow[4];                           //!!! DO NOT USE OR EDIT THIS !!! (Copy of REG00h - REG03h)
+  ADS1220_Scan_t * volatile Scan;                 //!!! DO NOT USE OR EDIT THIS !!! (Active scan)
+  ADS1220_PowerState_t PowerState;                //!!! DO NOT USE OR EDIT THIS !!! (See ADS1220_GetPowerState)
+  uint32_t LastConversion_US;                     //!!! DO NOT USE OR EDIT THIS !!! (ADC_GetTime_US of the last data read)
 } ADS1220_Handler_t;
 
 /**
@@ -291,15 +499,107 @@ ADS1220_Parameters_s {
   // See ADS1220_IDACrouting enum , This is for IDAC2
   ADS1220_IDACrouting_t    IDAC2routing; // default: Off
   // This bit controls the behavior of the DOUT/DRDY pin when new data are ready.
-  bool                     DRDYMode; // 0: Only the dedicated DRDY pin is used to indicate when data are ready (default) | 1: Data ready is indicated simultaneously on DOUT/DRDY and DRDY
+  bool                     DRDYMode; // 0: Only the dedicated DRDY pin is used to indicate when data are ready (default) | 1: Data ready is indicated simultaneously on DOUT/DRDY and DRDY (Needed by ADC_MISO_Get)
 } ADS1220_Parameters_t;
 
+/**
+ * @brief  Bus Scheduler for several ADS1220s sharing one SPI bus
+ * @note   Use ADS1220_BusInit to initialize it. Give each handler its own Context and use
+ *         ADC_CS_Write and ADC_DRDY_Get, so one set of callbacks serves all devices.
+ */
+typedef struct
+ADS1220_Bus_s {
+  ADS1220_Handler_t **Devices;                    // Pointer Of Handlers Array
+  uint8_t  Count;                                 // Number of Devices (1 - 32)
+  int32_t  *Samples;                              // Last sample of each device | [0]: Devices[0]
+  volatile uint32_t ReadyMask;                    // Bit i is set when Devices[i] has a new sample since ADS1220_BusStart
+  uint32_t SampleCounter;                         // Total number of samples read
+  void (*OnSample)(struct ADS1220_Bus_s *Bus, uint8_t Index, int32_t Sample); // Can be initialized - Called after each read
+  void *UserData;                                 // Can be initialized - User pointer
+} ADS1220_Bus_t;
+
+/**
+ * @brief  Running statistics of one channel (Exact integer sums relative to the first sample, no sample storage)
+ * @note   Use ADS1220_StatsMean, ADS1220_StatsVariance and ADS1220_StatsPeakToPeak to read the derived values.
+ *         Sums are exact for up to 65535 samples at any input swing.
+ */
+typedef struct
+ADS1220_Stats_s {
+  uint32_t Count;                                 // Number of samples
+  int32_t  Min;                                   // Smallest sample
+  int32_t  Max;                                   // Largest sample
+  int32_t  First;                                 // First sample (Offset of the sums)
+  int64_t  Sum;                                   // Sum of (Sample - First)
+  uint64_t SumSq;                                 // Sum of (Sample - First)^2
+} ADS1220_Stats_t;
+
+/**
+ * @brief  Auto-range State of the channels of a sequence
+ * @note   Use ADS1220_AutoRangeInit to initialize it.
+ */
+typedef struct
+ADS1220_AutoRange_s {
+  uint8_t  Gain[ADS1220_SEQUENCE_MAX];            // Gain of each channel for the next scan (See ADS1220_GainConfig enum)
+  uint8_t  MaxGain[ADS1220_SEQUENCE_MAX];         // Highest allowed gain of each channel
+  int32_t  Upper;                                 // Gain goes down above this |ADC value|
+  int32_t  Lower;                                 // Gain goes up while the predicted |ADC value| stays below this
+  uint8_t  Count;                                 // Number of channels
+} ADS1220_AutoRange_t;
+
+/**
+ * @brief  Profile Bank: Named configurations with precomputed register images
+ * @note   Use ADS1220_ProfileBankInit to initialize it and ADS1220_ProfileAdd to fill it.
+ */
+typedef struct
+ADS1220_ProfileBank_s {
+  uint8_t  Image[ADS1220_PROFILE_MAX][4];         // Registers (REG00h - REG03h) of each profile
+  const char *Name[ADS1220_PROFILE_MAX];          // Name of each profile (Not copied)
+  uint8_t  Count;                                 // Number of profiles
+} ADS1220_ProfileBank_t;
+
 /**
  ** ==================================================================================
  **                          ##### Public Functions #####                               
  ** ==================================================================================
  **/
 
+/**
+ * @brief  Calculates the minimum SPI timing profile from datasheet timing requirements
+ * @note   Each time is rounded up to the next MicroSecond.
+ * @param  Timing:      Pointer Of Timing Profile
+ * @param  SPIClock_Hz: SPI clock (SCLK) frequency in Hz
+ * @param  fCLK_Hz:     ADS1220 clock (fCLK) frequency in Hz | 4096000: Internal oscillator
+ * @retval None
+ */
+void
+ADS1220_TimingInit(ADS1220_Timing_t *Timing, uint32_t SPIClock_Hz, uint32_t fCLK_Hz);
+
+/**
+ * @brief  Conversion timing model of a configuration
+ * @note   Times are rounded up to the next MicroSecond. The 50/60Hz FIR filter only runs at 20SPS (Normal mode)
+ *         and 5SPS (Duty-cycle mode), so it is covered by those entries.
+ *         Duty-cycle mode converts like Normal mode at 4x the data rate and idles in between.
+ * @param  DataRate:      See ADS1220_DataRate enum
+ * @param  OperatingMode: See ADS1220_OperatingMode enum
+ * @param  fCLK_Hz:       ADS1220 clock (fCLK) frequency in Hz | 4096000: Internal oscillator
+ * @param  Timing:        Pointer Of Conversion Timing
+ * @retval None
+ */
+void
+ADS1220_GetConversionTiming(ADS1220_DataRate_t DataRate, ADS1220_OperatingMode_t OperatingMode, uint32_t fCLK_Hz, ADS1220_ConversionTiming_t *Timing);
+
+/**
+ * @brief  Waits for DRDY LOW without spinning for the whole conversion
+ * @note   Sleeps (ADC_Sleep_US, or ADC_Delay_US) for ADS1220_DRDY_SLEEP_PERCENT of Expected_US, then polls DRDY.
+ *         Gives up after ADS1220_DRDY_TIMEOUT_PERCENT of Expected_US (measured by ADC_GetTime_US if initialized).
+ *         Without DRDY pin callbacks, DOUT/DRDY is polled by ADC_MISO_Get while CS is held LOW.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Expected_US: Expected time to DRDY LOW in MicroSecond (See ADS1220_GetConversionTiming)
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time
+ */
+ADS1220_Result_t
+ADS1220_WaitDRDY(ADS1220_Handler_t *ADC_Handler, uint32_t Expected_US);
+
 /**
  * @brief  Initializes The ADC and Library
  * @note   If You pass Parameters as NULL, All Settings will be set as default. See ADS1220_Parameters struct to know what are default values.
@@ -310,6 +610,23 @@ ADS1220_Parameters_s {
 void
 ADS1220_Init(ADS1220_Handler_t *ADC_Handler, ADS1220_Parameters_t * Parameters);
 
+/**
+ * @brief  Initializes The ADC and Library, keeping the running configuration after a warm restart of the MCU
+ * @note   One burst RREG reads REG00h - REG03h. If they already equal Parameters and ADS1220 is alive (A fresh DRDY
+ *         HIGH to LOW transition after the pending data is read), RESET and register writes are skipped and Continuous
+ *         conversion mode keeps running without losing samples. In Single-shot mode, or if the conversions were stopped,
+ *         one START/SYNC and conversion proves it. All 0x00 or all 0xFF registers are never trusted.
+ *         Otherwise ADS1220 is reset and only the registers that differ from the default values are written (One WREG).
+ *         A DRDY source (ADC_DRDY_Read, ADC_DRDY_Get or ADC_MISO_Get with DRDYMode = 1) is needed for a warm restart.
+ *         If You pass Parameters as NULL, All Settings will be set as default.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Parameters:  Pointer Of ADC Parameters
+ * @retval true:  Warm restart, the configuration of ADS1220 was kept
+ *         false: ADS1220 was reset and configured
+ */
+bool
+ADS1220_InitFast(ADS1220_Handler_t *ADC_Handler, ADS1220_Parameters_t * Parameters);
+
 /**
  * @brief  Starts (in Single-shot mode) or Syncs (in Continuous conversion mode) Conversion
  * @param  ADC_Handler: Pointer Of Library Handler
@@ -344,6 +661,18 @@ ADS1220_PowerDown(ADS1220_Handler_t *ADC_Handler);
 void
 ADS1220_ReadData(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample);
 
+/**
+ * @brief  Waits for DOUT/DRDY LOW and reads Data in the same frame (No DRDY pin needed)
+ * @note   ADC_MISO_Get must be initialized and DRDYMode must be 1 (See ADS1220_Parameters struct).
+ *         CS is held LOW while waiting, so the SPI bus is busy until the data is read.
+ *         In Single-shot mode call ADS1220_StartSync first.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Elements: 1
+ * @retval ResultOK | ResultTimeout: DOUT/DRDY did not go LOW in time
+ */
+ADS1220_Result_t
+ADS1220_ReadDataDOUT(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample);
+
 /**
  * @brief  Changes the Configurations
  * @note   Pass Parameters as NULL to change settings to default Values. See ADS1220_Parameters struct to know what are default values
@@ -391,9 +720,10 @@ ADS1220_ActivateContinuousMode(ADS1220_Handler_t *ADC_Handler);
  * @param  ADCSample:   Pointer Of Samples Array | Number of Element: 2 | [0]: Channel1
  * @param  GainConfig:  Gain Configuration | Number of Element: 2 | [0]: Channel1
  *                      - See ADS1220_GainConfig enum
- * @retval None
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ *                  | ResultWrongMode: ADS1220 is not in Single-shot Mode
  */
-void
+ADS1220_Result_t
 ADS1220_ReadAllSingleShotDiff(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig);
 
 /**
@@ -407,9 +737,10 @@ ADS1220_ReadAllSingleShotDiff(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample
  * @param  ADCSample:   Pointer Of Samples Array | Number of Element: 2 | [0]: Channel1
  * @param  GainConfig:  Gain Configuration | Number of Element: 2 | [0]: Channel1
  *                      - See ADS1220_GainConfig enum
- * @retval None
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ *                  | ResultWrongMode: ADS1220 is not in Continuous conversion Mode
  */
-void
+ADS1220_Result_t
 ADS1220_ReadAllContinuousDiff(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig);
 
 /**
@@ -427,9 +758,10 @@ ADS1220_ReadAllContinuousDiff(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample
  * @param  GainConfig:  Gain Configuration | Number of Element: 4 | [0]: Channel1
  *         @note        Gains must be only 1, 2, and 4. See ADS1220_InputMuxConfig struct for more details.
  *                      - See ADS1220_GainConfig enum
- * @retval None
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ *                  | ResultWrongMode: ADS1220 is not in Single-shot Mode
  */
-void
+ADS1220_Result_t
 ADS1220_ReadAllSingleShotAVSS(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig);
 
 /**
@@ -447,10 +779,547 @@ ADS1220_ReadAllSingleShotAVSS(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample
  * @param  GainConfig:  Gain Configuration | Number of Element: 4 | [0]: Channel1
  *         @note        Gains must be only 1, 2, and 4. See ADS1220_InputMuxConfig struct for more details.
  *                      - See ADS1220_GainConfig enum
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ *                  | ResultWrongMode: ADS1220 is not in Continuous conversion Mode
+ */
+ADS1220_Result_t
+ADS1220_ReadAllContinuousAVSS(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig);
+
+/**
+ * @brief  Reads Count registers starting from FirstReg (One burst RREG)
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  FirstReg:    First register to read | 0: REG00h ... 3: REG03h
+ * @param  Count:       Number of registers to read | FirstReg + Count must be <= 4
+ * @param  ReadValues:  Pointer Of Registers Array | Number of Elements: Count | [0]: FirstReg
+ * @retval true:  Registers were read
+ *         false: Invalid range, nothing was sent
+ */
+bool
+ADS1220_ReadRegs(ADS1220_Handler_t *ADC_Handler, uint8_t FirstReg, uint8_t Count, uint8_t *ReadValues);
+
+/**
+ * @brief  Reloads the shadow registers from ADS1220 (One burst RREG)
+ * @note   The library keeps a copy of REG00h - REG03h and never reads them back to change a setting.
+ *         Use this when the hardware state is suspect (e.g. after a glitch or when another master wrote the registers).
+ * @param  ADC_Handler: Pointer Of Library Handler
  * @retval None
  */
 void
-ADS1220_ReadAllContinuousAVSS(ADS1220_Handler_t *ADC_Handler, int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig);
+ADS1220_SyncShadow(ADS1220_Handler_t *ADC_Handler);
+
+/**
+ * @brief  Verifies the ADS1220 registers against the shadow registers (One burst RREG)
+ * @note   The shadow registers are not changed. Use ADS1220_SyncShadow or ADS1220_ChangeConfig to fix the mismatch.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @retval true:  All registers match the shadow registers
+ *         false: At least one register does not match the shadow registers
+ */
+bool
+ADS1220_VerifyShadow(ADS1220_Handler_t *ADC_Handler);
+
+/**
+ * @brief  Initializes a configuration scrubber
+ * @param  Scrub:     Pointer Of Scrubber
+ * @param  Interval:  Check every Interval calls of ADS1220_ScrubTick (e.g. conversions) | 0: Disabled
+ * @param  Period_US: Check when Period_US MicroSeconds passed since the last check (ADC_GetTime_US must be initialized) | 0: Disabled
+ * @retval None
+ */
+void
+ADS1220_ScrubInit(ADS1220_Scrub_t *Scrub, uint16_t Interval, uint32_t Period_US);
+
+/**
+ * @brief  Verifies the ADS1220 registers against the shadow registers and repairs them
+ * @note   One burst RREG per check. On a mismatch (e.g. ESD or brown-out) the contiguous range of corrupted registers
+ *         is rewritten in one WREG and, in Continuous conversion mode, the conversions are restarted.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Scrub:       Pointer Of Scrubber
+ * @retval true:  Registers were corrupted and repaired (Scrub->Repairs is incremented)
+ *         false: All registers match the shadow registers
+ */
+bool
+ADS1220_ScrubCheck(ADS1220_Handler_t *ADC_Handler, ADS1220_Scrub_t *Scrub);
+
+/**
+ * @brief  Runs ADS1220_ScrubCheck when it is due
+ * @note   Call this after every conversion (Interval) and/or from a timer (Period_US).
+ *         If Scrub is initialized in ADC_Handler, ADS1220_OnDRDY calls this after every sample.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Scrub:       Pointer Of Scrubber
+ * @retval true:  A check was done and registers were repaired
+ *         false: No check was due or all registers matched
+ */
+bool
+ADS1220_ScrubTick(ADS1220_Handler_t *ADC_Handler, ADS1220_Scrub_t *Scrub);
+
+/**
+ * @brief  Writes a register image (Only the registers that differ from the shadow registers, in one WREG)
+ * @note   Writing a register restarts the running conversion.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Image:       REG00h - REG03h values | Number of Elements: 4 | [0]: REG00h
+ * @retval true:  Registers were written
+ *         false: Image equals the current configuration, nothing was sent
+ */
+bool
+ADS1220_WriteImage(ADS1220_Handler_t *ADC_Handler, const uint8_t *Image);
+
+/**
+ * @brief  Reads Data and writes a register image in the same frame
+ * @note   Call This function when DRDY pin got LOW. Only the registers that differ from the shadow registers are written.
+ *         One frame in Continuous conversion mode with ADC_Transfer or ADC_TransmitReceive. Otherwise Data is read
+ *         first and the registers are written in a second frame.
+ *         In Single-shot mode the next conversion still needs ADS1220_StartSync.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Image:       REG00h - REG03h values | Number of Elements: 4 | [0]: REG00h
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Elements: 1
+ * @retval true:  Registers were written
+ *         false: Image equals the current configuration, only the data was read
+ */
+bool
+ADS1220_ReadDataWriteImage(ADS1220_Handler_t *ADC_Handler, const uint8_t *Image, int32_t *ADCSample);
+
+/**
+ * @brief  Checks the DRDY pin
+ * @note   ADC_DRDY_Read or ADC_DRDY_Get must be initialized (or ADC_MISO_Get with DRDYMode = 1).
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @retval true:  New data is ready (DRDY is LOW)
+ *         false: Conversion is in progress
+ */
+bool
+ADS1220_IsDataReady(ADS1220_Handler_t *ADC_Handler);
+
+/**
+ * @brief  Device state tracked by the library
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @retval See ADS1220_PowerState enum
+ */
+ADS1220_PowerState_t
+ADS1220_GetPowerState(ADS1220_Handler_t *ADC_Handler);
+
+/**
+ ** ==================================================================================
+ **                       ##### Bus Scheduler Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes a Bus Scheduler for several ADS1220s sharing one SPI bus
+ * @note   Each device must be initialized by ADS1220_Init before ADS1220_BusStart.
+ * @param  Bus:         Pointer Of Bus Scheduler
+ * @param  Devices:     Pointer Of Handlers Array | Number of Elements: Count
+ * @param  Count:       Number of Devices (1 - 32)
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Elements: Count | [0]: Devices[0]
+ * @retval None
+ */
+void
+ADS1220_BusInit(ADS1220_Bus_t *Bus, ADS1220_Handler_t **Devices, uint8_t Count, int32_t *ADCSample);
+
+/**
+ * @brief  Starts conversion on all devices of the bus
+ * @note   Devices in Single-shot mode are restarted by ADS1220_BusPoll as soon as their data is read.
+ * @param  Bus:         Pointer Of Bus Scheduler
+ * @retval None
+ */
+void
+ADS1220_BusStart(ADS1220_Bus_t *Bus);
+
+/**
+ * @brief  Reads every device whose DRDY is LOW (One pass, Non-blocking)
+ * @note   A device in Single-shot mode is restarted right after its read, so it converts while the
+ *         other devices are read or reconfigured. Call this from the main loop or a timer.
+ *         DRDY is checked by ADS1220_IsDataReady, so devices without DRDY pin (DOUT/DRDY) are supported.
+ * @param  Bus:         Pointer Of Bus Scheduler
+ * @retval Number of samples read in this pass
+ */
+uint8_t
+ADS1220_BusPoll(ADS1220_Bus_t *Bus);
+
+/**
+ * @brief  Reads one new sample from every device of the bus
+ * @note   Conversions of all devices run in parallel, so this takes about one conversion period
+ *         regardless of the number of devices. Devices[0] provides the time base (ADC_GetTime_US or ADC_Delay_US).
+ *         An empty bus (Count = 0) returns ResultOK at once.
+ * @param  Bus:         Pointer Of Bus Scheduler
+ * @retval ResultOK | ResultTimeout: A device did not have data within ADS1220_DRDY_TIMEOUT_PERCENT of the
+ *                                   longest expected conversion time (Samples of the other devices are valid, See ReadyMask)
+ */
+ADS1220_Result_t
+ADS1220_BusReadAll(ADS1220_Bus_t *Bus);
+
+/**
+ ** ==================================================================================
+ **                            ##### Scan Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Starts a Non-blocking scan of all channels
+ * @note   Call ADS1220_OnDRDY from the DRDY falling edge interrupt. The scan advances one channel per DRDY
+ *         with no busy-waiting and calls Callback when all channels are read.
+ *         In Continuous conversion mode the next channel is written in the same frame that reads the
+ *         previous one (With ADC_Transfer or ADC_TransmitReceive). In Single-shot mode the read, the WREG
+ *         and the START/SYNC are separate frames.
+ *         Pass GainConfig as NULL to use current values for gain configurations.
+ *         At the end, configurations will be changed to previous values.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Scan:        Pointer Of Scan State | Must stay valid until the scan is done
+ * @param  ScanType:    Channels to scan
+ *                      - ScanDiff: Channel1: AIN0 - AIN1 | Channel2: AIN2 - AIN3
+ *                      - ScanAVSS: Channel1 - Channel4: AIN0 - AIN3 to AVSS (PGA disabled, Gains must be only 1, 2, and 4)
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Element: 2 (ScanDiff) or 4 (ScanAVSS) | [0]: Channel1 | Can be NULL if Ring is initialized
+ * @param  GainConfig:  Gain Configuration | Number of Element: 2 (ScanDiff) or 4 (ScanAVSS) | [0]: Channel1
+ *                      - See ADS1220_GainConfig enum
+ * @param  Callback:    Called (from ADS1220_OnDRDY) when all channels are read | Can be NULL
+ * @retval None
+ */
+void
+ADS1220_ScanStart(ADS1220_Handler_t *ADC_Handler, ADS1220_Scan_t *Scan, ADS1220_ScanType_t ScanType,
+                  int32_t *ADCSample, ADS1220_GainConfig_t *GainConfig, ADS1220_ScanCallback_t Callback);
+
+/**
+ * @brief  Advances the active scan by one channel
+ * @note   Call this from the DRDY falling edge interrupt (or when DRDY got LOW).
+ *         If Ring is initialized in ADC_Handler, every sample is also pushed to it. Without an active scan
+ *         the current channel is read and pushed to Ring (Channel: 0), or nothing is done if Ring is NULL.
+ *         If Scrub is initialized in ADC_Handler, ADS1220_ScrubTick is called after every sample.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @retval None
+ */
+void
+ADS1220_OnDRDY(ADS1220_Handler_t *ADC_Handler);
+
+/**
+ * @brief  Precomputes the register images of a channel sequence
+ * @note   REG01h and the settings that are not overridden are taken from the current configuration,
+ *         so call this after ADS1220_Init or ADS1220_ChangeConfig.
+ *         For settings where AINN = AVSS, the PGA is disabled automatically.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Sequence:    Pointer Of Sequence
+ * @param  Entries:     Pointer Of Entries Array | Number of Elements: Count | [0]: Channel1
+ * @param  Count:       Number of Entries (1 - ADS1220_SEQUENCE_MAX)
+ * @retval true:  Sequence is ready
+ *         false: Count is out of range or an AINN = AVSS entry uses a gain higher than 4
+ */
+bool
+ADS1220_SequenceInit(ADS1220_Handler_t *ADC_Handler, ADS1220_Sequence_t *Sequence, const ADS1220_SequenceEntry_t *Entries, uint8_t Count);
+
+/**
+ * @brief  Starts a Non-blocking scan of a channel sequence
+ * @note   Works the same as ADS1220_ScanStart. Only the registers that differ from the previous
+ *         channel are written, in one WREG frame.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Scan:        Pointer Of Scan State | Must stay valid until the scan is done
+ * @param  Sequence:    Pointer Of Sequence initialized by ADS1220_SequenceInit
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Element: Sequence->Count | [0]: Channel1 | Can be NULL if Ring is initialized
+ * @param  Callback:    Called (from ADS1220_OnDRDY) when all channels are read | Can be NULL
+ * @retval None
+ */
+void
+ADS1220_ScanSequenceStart(ADS1220_Handler_t *ADC_Handler, ADS1220_Scan_t *Scan, ADS1220_Sequence_t *Sequence,
+                          int32_t *ADCSample, ADS1220_ScanCallback_t Callback);
+
+/**
+ * @brief  Reads all channels of a channel sequence (Blocking)
+ * @note   ADC_DRDY_Read or ADC_DRDY_Get must be initialized.
+ *         At the end, configurations will be changed to previous values.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Sequence:    Pointer Of Sequence initialized by ADS1220_SequenceInit
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Element: Sequence->Count | [0]: Channel1
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ */
+ADS1220_Result_t
+ADS1220_ReadSequence(ADS1220_Handler_t *ADC_Handler, ADS1220_Sequence_t *Sequence, int32_t *ADCSample);
+
+/**
+ ** ==================================================================================
+ **                       ##### Ring Buffer Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes a Single-producer/Single-consumer lock-free sample ring buffer
+ * @param  Ring:        Pointer Of Ring Buffer
+ * @param  Buffer:      Pointer Of Records Array | Number of Elements: Size
+ * @param  Size:        Number of Records | Must be a power of two (2 - 32768)
+ * @retval true:  Ring buffer is ready
+ *         false: Size is not a power of two
+ */
+bool
+ADS1220_RingInit(ADS1220_Ring_t *Ring, ADS1220_Record_t *Buffer, uint16_t Size);
+
+/**
+ * @brief  Pushes one record (Producer side, e.g. DRDY interrupt)
+ * @note   If the ring buffer is full, the record is dropped and Dropped is incremented.
+ * @param  Ring:        Pointer Of Ring Buffer
+ * @param  Record:      Pointer Of Record
+ * @retval true:  Record is stored
+ *         false: Ring buffer is full
+ */
+bool
+ADS1220_RingPush(ADS1220_Ring_t *Ring, const ADS1220_Record_t *Record);
+
+/**
+ * @brief  Pops up to MaxCount records (Consumer side, e.g. processing task)
+ * @param  Ring:        Pointer Of Ring Buffer
+ * @param  Records:     Pointer Of Records Array | Number of Elements: MaxCount
+ * @param  MaxCount:    Maximum number of records to pop
+ * @retval Number of popped records
+ */
+uint16_t
+ADS1220_RingPop(ADS1220_Ring_t *Ring, ADS1220_Record_t *Records, uint16_t MaxCount);
+
+/**
+ * @brief  Number of records waiting in the ring buffer
+ * @param  Ring:        Pointer Of Ring Buffer
+ * @retval Number of records
+ */
+uint16_t
+ADS1220_RingCount(ADS1220_Ring_t *Ring);
+
+/**
+ ** ==================================================================================
+ **                       ##### Command Stream Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Compiles one scan cycle of a channel sequence into a flat SPI command stream
+ * @note   The stream holds every frame (WREG, START/SYNC and data read) of the scan in one contiguous
+ *         TX buffer. Each frame is one CS LOW period. Frames with ADS1220_STREAM_WAIT_DRDY must wait for
+ *         DRDY before they are sent. The RX layout of each sample is in SampleOffset.
+ *         In Continuous conversion mode with ADC_Transfer or ADC_TransmitReceive the WREG of the next entry
+ *         is pipelined with the data read; Otherwise the read, the WREG and the START/SYNC are separate frames.
+ *         The stream starts from the current registers and mode, so it must be recompiled after
+ *         ADS1220_ChangeConfig. At the end, configurations are changed to the values before the stream.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Stream:      Pointer Of Command Stream
+ * @param  Sequence:    Pointer Of Sequence initialized by ADS1220_SequenceInit
+ * @retval None
+ */
+void
+ADS1220_StreamCompile(ADS1220_Handler_t *ADC_Handler, ADS1220_Stream_t *Stream, ADS1220_Sequence_t *Sequence);
+
+/**
+ * @brief  Runs a compiled command stream (Blocking)
+ * @note   Each frame is sent in one CS LOW period. ADC_DRDY_Read or ADC_DRDY_Get must be initialized.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Stream:      Pointer Of Command Stream compiled by ADS1220_StreamCompile
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Element: Stream->SampleCount | [0]: Channel1
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The registers before the stream are written back)
+ */
+ADS1220_Result_t
+ADS1220_StreamRun(ADS1220_Handler_t *ADC_Handler, ADS1220_Stream_t *Stream, int32_t *ADCSample);
+
+/**
+ * @brief  Decodes the samples of a command stream from its RX buffer
+ * @note   Use this after sending the stream by your own DMA engine (RX bytes must be in Stream->RxData).
+ *         The shadow registers are updated to the state at the end of the stream.
+ * @param  ADC_Handler: Pointer Of Library Handler | Can be NULL to only decode
+ * @param  Stream:      Pointer Of Command Stream
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Element: Stream->SampleCount | [0]: Channel1
+ * @retval None
+ */
+void
+ADS1220_StreamDecode(ADS1220_Handler_t *ADC_Handler, const ADS1220_Stream_t *Stream, int32_t *ADCSample);
+
+/**
+ ** ==================================================================================
+ **                         ##### Oversampling Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Resets running statistics
+ * @param  Stats:       Pointer Of Statistics
+ * @retval None
+ */
+void
+ADS1220_StatsReset(ADS1220_Stats_t *Stats);
+
+/**
+ * @brief  Adds one sample to running statistics
+ * @note   Integer only (One 32x32 -> 64 bit multiply), no rounding.
+ * @param  Stats:       Pointer Of Statistics
+ * @param  Sample:      ADC value
+ * @retval None
+ */
+void
+ADS1220_StatsUpdate(ADS1220_Stats_t *Stats, int32_t Sample);
+
+/**
+ * @brief  Mean of running statistics in ADC codes
+ * @param  Stats:       Pointer Of Statistics
+ * @retval Mean | 0 if there is no sample
+ */
+double
+ADS1220_StatsMean(const ADS1220_Stats_t *Stats);
+
+/**
+ * @brief  Sample variance of running statistics in ADC codes^2
+ * @param  Stats:       Pointer Of Statistics
+ * @retval Variance | 0 if less than 2 samples
+ */
+double
+ADS1220_StatsVariance(const ADS1220_Stats_t *Stats);
+
+/**
+ * @brief  Peak-to-peak of running statistics in ADC codes
+ * @param  Stats:       Pointer Of Statistics
+ * @retval Max - Min | 0 if there is no sample
+ */
+int32_t
+ADS1220_StatsPeakToPeak(const ADS1220_Stats_t *Stats);
+
+/**
+ * @brief  Collects Count conversions of the current channel into running statistics (Blocking)
+ * @note   ADC_DRDY_Read or ADC_DRDY_Get must be initialized.
+ *         Works in both Single-shot and Continuous conversion mode. No sample is stored.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Stats:       Pointer Of Statistics (Reset by this function)
+ * @param  Count:       Number of conversions
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time
+ */
+ADS1220_Result_t
+ADS1220_ReadOversampled(ADS1220_Handler_t *ADC_Handler, ADS1220_Stats_t *Stats, uint16_t Count);
+
+/**
+ * @brief  Collects Count conversions of each channel of a sequence into running statistics (Blocking)
+ * @note   ADC_DRDY_Read or ADC_DRDY_Get must be initialized.
+ *         Each channel is configured once and converted Count times, so the settling of the first conversion
+ *         is paid once per channel. The last read of a channel and the write of the next one share one frame.
+ *         Use ADS1220_SequenceInit with AIN0-AIN1/AIN2-AIN3 or AINx-AVSS entries for the ReadAll channel sets.
+ *         At the end, configurations will be changed to previous values.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Sequence:    Pointer Of Sequence initialized by ADS1220_SequenceInit
+ * @param  Stats:       Pointer Of Statistics Array | Number of Element: Sequence->Count | [0]: Channel1
+ * @param  Count:       Number of conversions per channel
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (The scan is stopped)
+ */
+ADS1220_Result_t
+ADS1220_ReadSequenceOversampled(ADS1220_Handler_t *ADC_Handler, ADS1220_Sequence_t *Sequence, ADS1220_Stats_t *Stats, uint16_t Count);
+
+/**
+ ** ==================================================================================
+ **                          ##### Auto-range Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes auto-ranging of the channels of a sequence
+ * @note   Each channel starts with the gain of its sequence entry. Gains are limited to 1, 2 and 4 for
+ *         entries with the PGA disabled (AINN = AVSS settings are always PGA disabled).
+ *         Gain goes down when a sample passes (100 - HeadroomPercent)% of full scale, and goes up to the
+ *         highest gain whose predicted sample stays below (100 - HeadroomPercent - HysteresisPercent)% of full scale.
+ * @param  AutoRange:         Pointer Of Auto-range State
+ * @param  Sequence:          Pointer Of Sequence initialized by ADS1220_SequenceInit
+ * @param  HeadroomPercent:   Headroom below full scale (0 - 99), E.g. 10
+ * @param  HysteresisPercent: Extra margin needed to increase gain (0 - 99), E.g. 10
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_AutoRangeInit(ADS1220_AutoRange_t *AutoRange, const ADS1220_Sequence_t *Sequence, uint8_t HeadroomPercent, uint8_t HysteresisPercent);
+
+/**
+ * @brief  Writes the current gain of each channel into the register images of a sequence
+ * @note   Call it before ADS1220_ScanSequenceStart or ADS1220_ReadSequence. The gain then goes out in the
+ *         same WREG frame as the input multiplexer of the channel.
+ * @param  AutoRange:   Pointer Of Auto-range State
+ * @param  Sequence:    Pointer Of Sequence
+ * @retval None
+ */
+void
+ADS1220_AutoRangeApply(const ADS1220_AutoRange_t *AutoRange, ADS1220_Sequence_t *Sequence);
+
+/**
+ * @brief  Normalises the samples of a sequence to gain 128 and picks the gain of each channel for the next scan
+ * @note   Normalised = ADCSample * 128 / Gain, so values of all channels and gains are comparable
+ *         (ADCValueToVoltage(Normalised, VREF, 128) gives Volt). Full scale is +-2^30.
+ * @param  AutoRange:   Pointer Of Auto-range State
+ * @param  ADCSample:   Pointer Of Samples Array read with the current gains | [0]: Channel1
+ * @param  Normalised:  Pointer Of output Array | Number of Element: Sequence->Count | Can be equal to ADCSample
+ * @retval Bit i is set if the gain of channel i changed
+ */
+uint8_t
+ADS1220_AutoRangeUpdate(ADS1220_AutoRange_t *AutoRange, const int32_t *ADCSample, int32_t *Normalised);
+
+/**
+ * @brief  Reads all channels of a sequence with auto-ranged gains (Blocking)
+ * @note   Same as ADS1220_AutoRangeApply, ADS1220_ReadSequence and ADS1220_AutoRangeUpdate.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Sequence:    Pointer Of Sequence
+ * @param  AutoRange:   Pointer Of Auto-range State initialized for Sequence
+ * @param  Normalised:  Pointer Of Samples Array (Normalised to gain 128) | Number of Element: Sequence->Count | [0]: Channel1
+ *                      Not written on timeout
+ * @param  Changed:     Pointer Of gain change mask: Bit i is set if the gain of channel i changed for the next call
+ *                      Can be NULL | Set to 0 on timeout
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time (Normalised and the gains are unchanged)
+ */
+ADS1220_Result_t
+ADS1220_ReadSequenceAutoRange(ADS1220_Handler_t *ADC_Handler, ADS1220_Sequence_t *Sequence, ADS1220_AutoRange_t *AutoRange,
+                              int32_t *Normalised, uint8_t *Changed);
+
+/**
+ ** ==================================================================================
+ **                          ##### Profile Bank Functions #####                               
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes an empty profile bank
+ * @param  Bank: Pointer Of Profile Bank
+ * @retval None
+ */
+void
+ADS1220_ProfileBankInit(ADS1220_ProfileBank_t *Bank);
+
+/**
+ * @brief  Adds a profile and precomputes its register image
+ * @note   Parameters are packed as ADS1220_ChangeConfig does (Nothing is sent to ADS1220).
+ * @param  Bank:       Pointer Of Profile Bank
+ * @param  Name:       Name of the profile (The pointer is kept, so it must stay valid)
+ * @param  Parameters: Pointer Of ADC Parameters | NULL: Default values
+ * @retval Index of the profile | -1: The bank is full (ADS1220_PROFILE_MAX)
+ */
+int8_t
+ADS1220_ProfileAdd(ADS1220_ProfileBank_t *Bank, const char *Name, const ADS1220_Parameters_t *Parameters);
+
+/**
+ * @brief  Finds a profile by name
+ * @param  Bank: Pointer Of Profile Bank
+ * @param  Name: Name of the profile
+ * @retval Index of the profile | -1: Not found
+ */
+int8_t
+ADS1220_ProfileFind(const ADS1220_ProfileBank_t *Bank, const char *Name);
 
+/**
+ * @brief  Switches to a profile (At most one WREG)
+ * @note   Only the contiguous range of registers that differ from the current configuration is written.
+ *         Writing a register restarts the running conversion. In Single-shot mode the conversion still needs ADS1220_StartSync.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Bank:        Pointer Of Profile Bank
+ * @param  Index:       Index of the profile (See ADS1220_ProfileAdd and ADS1220_ProfileFind)
+ * @retval true:  Registers were written
+ *         false: The profile is already active or Index is invalid, nothing was sent
+ */
+bool
+ADS1220_ProfileSelect(ADS1220_Handler_t *ADC_Handler, const ADS1220_ProfileBank_t *Bank, int8_t Index);
+
+/**
+ * @brief  Reads Data and switches to a profile in the same frame
+ * @note   Call This function when DRDY pin got LOW. Same as ADS1220_ReadDataWriteImage with the image of the profile.
+ *         If Index is invalid, only the data is read.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Bank:        Pointer Of Profile Bank
+ * @param  Index:       Index of the profile (See ADS1220_ProfileAdd and ADS1220_ProfileFind)
+ * @param  ADCSample:   Pointer Of Samples Array | Number of Elements: 1
+ * @retval true:  Registers were written
+ *         false: The profile is already active or Index is invalid, only the data was read
+ */
+bool
+ADS1220_ReadDataProfileSelect(ADS1220_Handler_t *ADC_Handler, const ADS1220_ProfileBank_t *Bank, int8_t Index, int32_t *ADCSample);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif
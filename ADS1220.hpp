@@ -0,0 +1,295 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220.hpp
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Header-only C++ layer: compile-time configuration and inlined transport
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Define to prevent recursive inclusion ---------------------------------------- //
+#ifndef ADS1220_HPP
+#define ADS1220_HPP
+
+//* Includes ---------------------------------------------------------------------- //
+#include "ADS1220.h"
+
+//? User Configurations and Notes ------------------------------------------------- //
+// C++11 or later. Only the enums and macros of ADS1220.h are used, ADS1220.c is not needed.
+// A configuration is a type with the fields of ADS1220_Parameters_t as static constexpr members (Derive from
+// ads1220::DefaultConfig and override what you need). Register values are computed and checked at compile time.
+// A transport is a policy type, its functions are called directly (No function pointers):
+//   void    Select();                                                  // CS LOW
+//   void    Deselect();                                                // CS HIGH
+//   void    Transfer(const uint8_t *TxData, uint8_t *RxData, uint16_t Length); // Full-duplex, RxData can be NULL
+//   uint8_t DRDY();                                                    // DRDY level (0: Data ready)
+//   void    DelayUS(uint32_t Time_US);
+//
+//   struct Slow : ads1220::DefaultConfig { static constexpr ADS1220_GainConfig_t GainConfig = _128_; };
+//   ads1220::Device<MyTransport, Slow> ADC;
+//   ADC.Init();
+//   int32_t Sample;
+//   if (!ADC.Read(Sample)) { /* DRDY did not go LOW in time */ }
+//? ------------------------------------------------------------------------------- //
+
+namespace ads1220 {
+
+/**
+ ** ==================================================================================
+ **                            ##### Configuration #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Power-up configuration (Same defaults as ADS1220_Parameters_t)
+ */
+struct DefaultConfig {
+  // REG 00h
+  static constexpr ADS1220_InputMuxConfig_t InputMuxConfig    = P0N1;
+  static constexpr ADS1220_GainConfig_t     GainConfig        = _1_;
+  static constexpr bool                     PGAdisable        = false;
+  // REG 01h
+  static constexpr ADS1220_DataRate_t       DataRate          = _20_SPS_;
+  static constexpr ADS1220_OperatingMode_t  OperatingMode     = NormalMode;
+  static constexpr bool                     ConversionMode    = false; // 0: Single-shot mode | 1: Continuous conversion mode
+  static constexpr bool                     TempeSensorMode   = false;
+  static constexpr bool                     BurnOutCurrentSrc = false;
+  // REG 02h
+  static constexpr ADS1220_VoltageRef_t     VoltageRef        = Internal;
+  static constexpr ADS1220_FIRFilter_t      FIRFilter         = No50or60Hz;
+  static constexpr bool                     LowSidePwr        = false;
+  static constexpr ADS1220_IDACcurrent_t    IDACcurrent       = Off;
+  // REG 03h
+  static constexpr ADS1220_IDACrouting_t    IDAC1routing      = Disabled;
+  static constexpr ADS1220_IDACrouting_t    IDAC2routing      = Disabled;
+  static constexpr bool                     DRDYMode          = false;
+};
+
+/**
+ * @brief  Register values of a configuration, validated at compile time
+ */
+template <class Config>
+struct Registers {
+  static constexpr bool SingleEnded = Config::InputMuxConfig >= P0NAVSS && Config::InputMuxConfig <= P3NAVSS;
+
+  static_assert(Config::InputMuxConfig >= P0N1 && Config::InputMuxConfig <= Mode3, "InputMuxConfig is out of range");
+  static_assert(Config::GainConfig >= _1_ && Config::GainConfig <= _128_, "GainConfig is out of range");
+  static_assert(Config::DataRate >= 0 && Config::DataRate <= 6, "DataRate is out of range");
+  static_assert(Config::OperatingMode >= NormalMode && Config::OperatingMode <= TurboMode, "OperatingMode is out of range");
+  static_assert(Config::IDACcurrent >= Off && Config::IDACcurrent <= _1500uA_, "IDACcurrent is out of range");
+  static_assert(Config::IDAC1routing >= Disabled && Config::IDAC1routing <= REFN0, "IDAC1routing is out of range");
+  static_assert(Config::IDAC2routing >= Disabled && Config::IDAC2routing <= REFN0, "IDAC2routing is out of range");
+  static_assert(!SingleEnded || Config::GainConfig <= _4_, "AINN = AVSS: Only gains 1, 2 and 4 can be used");
+  static_assert(!SingleEnded || Config::PGAdisable, "AINN = AVSS: The PGA must be disabled (PGAdisable = true)");
+  static_assert(!Config::PGAdisable || Config::GainConfig <= _4_, "The PGA can only be disabled for gains 1, 2 and 4");
+  static_assert(Config::FIRFilter == No50or60Hz || (Config::DataRate == _20_SPS_ && Config::OperatingMode != TurboMode),
+                "The FIR filter is only for 20SPS in normal mode and 5SPS in duty-cycle mode");
+
+  static constexpr uint8_t Reg00h = (uint8_t)((Config::InputMuxConfig << 4) | (Config::GainConfig << 1) | (Config::PGAdisable ? 1 : 0));
+  static constexpr uint8_t Reg01h = (uint8_t)((Config::DataRate << 5) | (Config::OperatingMode << 3) | (Config::ConversionMode ? 0x04 : 0) |
+                                              (Config::TempeSensorMode ? 0x02 : 0) | (Config::BurnOutCurrentSrc ? 0x01 : 0));
+  static constexpr uint8_t Reg02h = (uint8_t)((Config::VoltageRef << 6) | (Config::FIRFilter << 4) | (Config::LowSidePwr ? 0x08 : 0) | Config::IDACcurrent);
+  static constexpr uint8_t Reg03h = (uint8_t)((Config::IDAC1routing << 5) | (Config::IDAC2routing << 2) | (Config::DRDYMode ? 0x02 : 0));
+
+  static constexpr uint8_t Get(uint8_t Register)
+  {
+    return Register == 0 ? Reg00h : Register == 1 ? Reg01h : Register == 2 ? Reg02h : Reg03h;
+  }
+};
+
+/**
+ * @brief  Conversion time of a configuration in us (Same as ADS1220_GetConversionTiming at ADS1220_FCLK_HZ, compile time)
+ */
+template <class Config>
+struct Timing {
+  // First conversion in modulator clocks (tMOD: 16 * tCLK in Normal mode, 8 * tCLK in Turbo mode)
+  static constexpr uint64_t FirstMOD(uint8_t Rate)
+  {
+    return Rate == 0 ? 13955 : Rate == 1 ? 6258 : Rate == 2 ? 3152 : Rate == 3 ? 1604 : Rate == 4 ? 860 : Rate == 5 ? 476 : 286;
+  }
+  // Normal mode data rates in 0.01SPS at fCLK = 4.096MHz
+  static constexpr uint64_t DataRateCSPS(uint8_t Rate)
+  {
+    return Rate == 0 ? 2000 : Rate == 1 ? 4500 : Rate == 2 ? 9000 : Rate == 3 ? 17500 : Rate == 4 ? 33000 : Rate == 5 ? 60000 : 100000;
+  }
+  static constexpr uint64_t NormalPeriodCUS = 10000000000ULL * 4096000ULL / (DataRateCSPS(Config::DataRate) * ADS1220_FCLK_HZ);
+  static constexpr uint64_t PeriodCUS = Config::OperatingMode == TurboMode ? NormalPeriodCUS / 2 :
+                                        Config::OperatingMode == DutyCycleMode ? NormalPeriodCUS * 4 : NormalPeriodCUS;
+  static constexpr uint64_t FirstNS = FirstMOD(Config::DataRate) * (Config::OperatingMode == TurboMode ? 8 : 16) * 1000000000ULL / ADS1220_FCLK_HZ;
+
+  static constexpr uint32_t PeriodUS = (uint32_t)((PeriodCUS + 99) / 100);
+  static constexpr uint32_t FirstConversionUS = (uint32_t)((FirstNS + 999) / 1000);
+  // Read gives up after ADS1220_DRDY_TIMEOUT_PERCENT of the longer of both (Same rule as ADS1220_WaitDRDY)
+  static constexpr uint32_t TimeoutUS = (uint32_t)((uint64_t)(FirstConversionUS > PeriodUS ? FirstConversionUS : PeriodUS) *
+                                                   ADS1220_DRDY_TIMEOUT_PERCENT / 100) + ADS1220_DRDY_POLL_US;
+};
+
+/**
+ * @brief  Smallest contiguous range of registers that differs between two configurations (Compile time)
+ */
+template <class From, class To>
+struct Difference {
+  static constexpr bool Differs(uint8_t Register)
+  {
+    return Registers<From>::Get(Register) != Registers<To>::Get(Register);
+  }
+  static constexpr uint8_t First = Differs(0) ? 0 : Differs(1) ? 1 : Differs(2) ? 2 : Differs(3) ? 3 : 4;
+  static constexpr uint8_t Last  = Differs(3) ? 3 : Differs(2) ? 2 : Differs(1) ? 1 : 0;
+  static constexpr uint8_t Count = First > 3 ? 0 : Last - First + 1; // 0: Nothing to write
+};
+
+/**
+ ** ==================================================================================
+ **                               ##### Device #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  ADS1220 with a compile-time configuration
+ * @note   The configuration is part of the type. ADS1220::Apply returns the device with the next configuration
+ *         and writes only the registers that differ (Known at compile time).
+ */
+template <class Transport, class Config = DefaultConfig>
+class Device {
+public:
+  typedef Registers<Config> Regs;
+
+  explicit Device(Transport Bus = Transport()) : Bus_(Bus) {}
+
+  /**
+   * @brief  Resets ADS1220 and writes the configuration (One WREG)
+   */
+  void Init()
+  {
+    Bus_.DelayUS(ResetUS); // Wait after power up at least 50us + 32 * tclk
+    Command(0x06);         // RESET
+    Bus_.DelayUS(ResetUS);
+    const uint8_t TxData[5] = {0x43, Regs::Reg00h, Regs::Reg01h, Regs::Reg02h, Regs::Reg03h}; // WREG REG00h - REG03h
+    Frame(TxData, nullptr, 5);
+  }
+
+  void StartSync() { Command(0x08); }
+  void PowerDown() { Command(0x02); }
+  bool IsDataReady() { return !Bus_.DRDY(); }
+
+  /**
+   * @brief  Reads Data (Call it when DRDY is LOW)
+   */
+  int32_t ReadData()
+  {
+    const uint8_t TxData[3] = {0, 0, 0};
+    uint8_t RxData[3];
+    Frame(TxData, RxData, 3);
+    return RawToAdcValue(RxData);
+  }
+
+  /**
+   * @brief  Waits for DRDY LOW, polling every ADS1220_DRDY_POLL_US with DelayUS
+   * @note   Gives up after Timing<Config>::TimeoutUS (ADS1220_DRDY_TIMEOUT_PERCENT of the conversion time, compile time).
+   * @retval false: DRDY did not go LOW in time (E.g. dead device or unconnected DRDY)
+   */
+  bool WaitDRDY()
+  {
+    for (uint32_t Waited = 0; Bus_.DRDY(); Waited += ADS1220_DRDY_POLL_US)
+    {
+      if (Waited > Timing<Config>::TimeoutUS) return false;
+      Bus_.DelayUS(ADS1220_DRDY_POLL_US);
+    }
+    return true;
+  }
+
+  /**
+   * @brief  Starts a conversion in Single-shot mode, waits for DRDY LOW (See WaitDRDY) and reads Data
+   * @retval false: DRDY did not go LOW in time, Sample is not written
+   */
+  bool Read(int32_t &Sample)
+  {
+    if (!Config::ConversionMode) StartSync();
+    if (!WaitDRDY()) return false;
+    Sample = ReadData();
+    return true;
+  }
+
+  /**
+   * @brief  Changes the configuration (Only the registers that differ, nothing if they are equal)
+   * @retval Device with the next configuration
+   */
+  template <class Next>
+  Device<Transport, Next> Apply()
+  {
+    typedef Difference<Config, Next> Diff;
+    (void)Registers<Next>::Reg00h; // Validates Next
+    if (Diff::Count)
+    {
+      uint8_t TxData[5] = {(uint8_t)(0x40 | (Diff::First << 2) | (Diff::Count - 1))};
+      for (uint8_t i = 0; i < Diff::Count; i++) TxData[i + 1] = Registers<Next>::Get(Diff::First + i);
+      Frame(TxData, nullptr, Diff::Count + 1);
+    }
+    return Device<Transport, Next>(Bus_);
+  }
+
+  /**
+   * @brief  Reads Data and changes the configuration in the same frame (Call it when DRDY is LOW)
+   * @retval Device with the next configuration
+   */
+  template <class Next>
+  Device<Transport, Next> ReadDataApply(int32_t &Sample)
+  {
+    typedef Difference<Config, Next> Diff;
+    (void)Registers<Next>::Reg00h; // Validates Next
+    uint8_t TxData[6] = {0, (uint8_t)(Diff::Count ? 0x40 | ((Diff::First & 0x03) << 2) | ((Diff::Count - 1) & 0x03) : 0)};
+    uint8_t RxData[6];
+    for (uint8_t i = 0; i < Diff::Count; i++) TxData[i + 2] = Registers<Next>::Get(Diff::First + i);
+    Frame(TxData, RxData, Diff::Count ? Diff::Count + 2 : 3);
+    Sample = RawToAdcValue(RxData);
+    return Device<Transport, Next>(Bus_);
+  }
+
+  Transport &Bus() { return Bus_; }
+
+private:
+  static constexpr uint32_t ResetUS = 50 + (32UL * 1000000UL + ADS1220_FCLK_HZ - 1) / ADS1220_FCLK_HZ;
+
+  static int32_t RawToAdcValue(const uint8_t *RxData)
+  {
+    return (int32_t)(((uint32_t)RxData[0] << 24) | ((uint32_t)RxData[1] << 16) | ((uint32_t)RxData[2] << 8)) / 256;
+  }
+
+  void Frame(const uint8_t *TxData, uint8_t *RxData, uint16_t Length)
+  {
+    Bus_.Select();
+    Bus_.Transfer(TxData, RxData, Length);
+    Bus_.Deselect();
+  }
+
+  void Command(uint8_t Command)
+  {
+    Frame(&Command, nullptr, 1);
+  }
+
+  Transport Bus_;
+};
+
+} // namespace ads1220
+
+#endif
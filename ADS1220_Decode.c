@@ -0,0 +1,213 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_Decode.c
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Batch decode of packed 24-bit ADS1220 sample streams
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Private Includes -------------------------------------------------------------- //
+#include "ADS1220_Decode.h"
+
+#if ADS1220_DECODE_SIMD && defined(__AVX2__)
+#define ADS1220_DECODE_AVX2
+#include <immintrin.h>
+#elif ADS1220_DECODE_SIMD && defined(__SSSE3__)
+#define ADS1220_DECODE_SSSE3
+#include <tmmintrin.h>
+#elif ADS1220_DECODE_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define ADS1220_DECODE_NEON
+#include <arm_neon.h>
+#endif
+
+//* Private Defines and Macros ---------------------------------------------------- //
+#define ADS1220_DECODE_CHUNK  64 // Samples decoded at once by the float variant
+
+#define ADS1220_DecodeOne(Raw) \
+  ((int32_t)(((uint32_t)(Raw)[0] << 24) | ((uint32_t)(Raw)[1] << 16) | ((uint32_t)(Raw)[2] << 8)) / 256)
+
+/**
+ *! ==================================================================================
+ *!                          ##### Private Functions #####
+ *! ==================================================================================
+ **/
+
+#if defined(ADS1220_DECODE_AVX2) || defined(ADS1220_DECODE_SSSE3)
+// Moves bytes {3i, 3i+1, 3i+2} of a 12-byte group to bytes {3, 2, 1} of lane i and zeroes byte 0
+#define ADS1220_DECODE_SHUFFLE  -1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9
+#endif
+
+#ifdef ADS1220_DECODE_AVX2
+// 8 samples (24 bytes) per iteration, reads 28 bytes
+static uint32_t
+ADS1220_DecodeSIMD (const uint8_t *RawData, int32_t *ADCSample, uint32_t Count)
+{
+  const __m256i Shuffle = _mm256_setr_epi8(ADS1220_DECODE_SHUFFLE, ADS1220_DECODE_SHUFFLE);
+  uint32_t i = 0;
+
+  for (; (uint64_t)i * 3 + 28 <= (uint64_t)Count * 3; i += 8)
+  {
+    __m256i Raw = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(RawData + i * 3))),
+                                          _mm_loadu_si128((const __m128i *)(RawData + i * 3 + 12)), 1);
+    _mm256_storeu_si256((__m256i *)(ADCSample + i), _mm256_srai_epi32(_mm256_shuffle_epi8(Raw, Shuffle), 8));
+  }
+  return i;
+};
+#elif defined(ADS1220_DECODE_SSSE3)
+// 4 samples (12 bytes) per iteration, reads 16 bytes
+static uint32_t
+ADS1220_DecodeSIMD (const uint8_t *RawData, int32_t *ADCSample, uint32_t Count)
+{
+  const __m128i Shuffle = _mm_setr_epi8(ADS1220_DECODE_SHUFFLE);
+  uint32_t i = 0;
+
+  for (; (uint64_t)i * 3 + 16 <= (uint64_t)Count * 3; i += 4)
+  {
+    __m128i Raw = _mm_loadu_si128((const __m128i *)(RawData + i * 3));
+    _mm_storeu_si128((__m128i *)(ADCSample + i), _mm_srai_epi32(_mm_shuffle_epi8(Raw, Shuffle), 8));
+  }
+  return i;
+};
+#elif defined(ADS1220_DECODE_NEON)
+// 8 samples (24 bytes) per iteration, de-interleaved by VLD3
+static uint32_t
+ADS1220_DecodeSIMD (const uint8_t *RawData, int32_t *ADCSample, uint32_t Count)
+{
+  uint32_t i = 0;
+
+  for (; i + 8 <= Count; i += 8)
+  {
+    uint8x8x3_t Raw  = vld3_u8(RawData + i * 3);
+    int16x8_t   High = vmovl_s8(vreinterpret_s8_u8(Raw.val[0]));           // Sign-extended MSB
+    uint16x8_t  Low  = vorrq_u16(vshll_n_u8(Raw.val[1], 8), vmovl_u8(Raw.val[2]));
+    vst1q_s32(ADCSample + i,     vorrq_s32(vshll_n_s16(vget_low_s16(High), 16),
+                                           vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(Low)))));
+    vst1q_s32(ADCSample + i + 4, vorrq_s32(vshll_n_s16(vget_high_s16(High), 16),
+                                           vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(Low)))));
+  }
+  return i;
+};
+#endif
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Name of the kernel used by ADS1220_DecodeBatch ("AVX2", "SSSE3", "NEON" or "Scalar")
+ * @retval Kernel name
+ */
+const char *
+ADS1220_DecodeKernel(void)
+{
+#if defined(ADS1220_DECODE_AVX2)
+  return "AVX2";
+#elif defined(ADS1220_DECODE_SSSE3)
+  return "SSSE3";
+#elif defined(ADS1220_DECODE_NEON)
+  return "NEON";
+#else
+  return "Scalar";
+#endif
+}
+
+/**
+ * @brief  Decodes packed 24-bit samples to sign-extended int32 with the portable scalar kernel
+ * @param  RawData:     Pointer Of packed samples (3 * Count bytes)
+ * @param  ADCSample:   Pointer Of output ADC values (Count elements)
+ * @param  Count:       Number of samples
+ * @retval None
+ */
+void
+ADS1220_DecodeBatchScalar(const uint8_t *RawData, int32_t *ADCSample, uint32_t Count)
+{
+  for (uint32_t i = 0; i < Count; i++, RawData += 3)
+    ADCSample[i] = ADS1220_DecodeOne(RawData);
+}
+
+/**
+ * @brief  Decodes packed 24-bit samples to sign-extended int32 with the fastest kernel of the target
+ * @param  RawData:     Pointer Of packed samples (3 * Count bytes)
+ * @param  ADCSample:   Pointer Of output ADC values (Count elements)
+ * @param  Count:       Number of samples
+ * @retval None
+ */
+void
+ADS1220_DecodeBatch(const uint8_t *RawData, int32_t *ADCSample, uint32_t Count)
+{
+  uint32_t Done = 0;
+#if defined(ADS1220_DECODE_AVX2) || defined(ADS1220_DECODE_SSSE3) || defined(ADS1220_DECODE_NEON)
+  Done = ADS1220_DecodeSIMD(RawData, ADCSample, Count);
+#endif
+  ADS1220_DecodeBatchScalar(RawData + Done * 3, ADCSample + Done, Count - Done);
+}
+
+/**
+ * @brief  Decodes packed 24-bit samples straight to scaled float: Output = ADCvalue * Scale
+ * @note   E.g. Scale = VREF / Gain / 0x7FFFFF gives Volt (Same as ADCValueToVoltage).
+ * @param  RawData:     Pointer Of packed samples (3 * Count bytes)
+ * @param  Output:      Pointer Of output values (Count elements)
+ * @param  Count:       Number of samples
+ * @param  Scale:       Output units per ADC code
+ * @retval None
+ */
+void
+ADS1220_DecodeBatchFloat(const uint8_t *RawData, float *Output, uint32_t Count, float Scale)
+{
+  int32_t Chunk[ADS1220_DECODE_CHUNK];
+
+  while (Count)
+  {
+    uint32_t Length = (Count < ADS1220_DECODE_CHUNK) ? Count : ADS1220_DECODE_CHUNK;
+    ADS1220_DecodeBatch(RawData, Chunk, Length);
+    for (uint32_t i = 0; i < Length; i++)
+      Output[i] = (float)Chunk[i] * Scale;
+    RawData += Length * 3;
+    Output += Length;
+    Count -= Length;
+  }
+}
+
+/**
+ * @brief  Decodes packed 24-bit samples straight to fixed-point values (See ADS1220_Fixed.h)
+ * @param  RawData:     Pointer Of packed samples (3 * Count bytes)
+ * @param  Output:      Pointer Of output values (Count elements)
+ * @param  Count:       Number of samples
+ * @param  Scale:       Pointer Of Scale
+ * @retval None
+ */
+void
+ADS1220_DecodeBatchFixed(const uint8_t *RawData, int32_t *Output, uint32_t Count, const ADS1220_FixedScale_t *Scale)
+{
+  ADS1220_DecodeBatch(RawData, Output, Count);
+  while (Count)
+  {
+    uint16_t Length = (Count < 0xFFFF) ? (uint16_t)Count : 0xFFFF;
+    ADS1220_FixedConvertBatch(Scale, Output, Output, Length);
+    Output += Length;
+    Count -= Length;
+  }
+}
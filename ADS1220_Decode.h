@@ -0,0 +1,108 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_Decode.h
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Batch decode of packed 24-bit ADS1220 sample streams
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Define to prevent recursive inclusion ---------------------------------------- //
+#ifndef ADS1220_DECODE_H
+#define ADS1220_DECODE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//* Includes ---------------------------------------------------------------------- //
+#include "ADS1220.h"
+#include "ADS1220_Fixed.h"
+
+//? User Configurations and Notes ------------------------------------------------- //
+// Input is packed big-endian 3 bytes per sample, as clocked out of DOUT (MSB first).
+// The kernel is chosen at compile time: AVX2 (-mavx2), SSSE3 (-mssse3), NEON (ARMv7 -mfpu=neon or AArch64) or scalar.
+#define ADS1220_DECODE_SIMD             1    // 0: Always use the scalar kernel | 1: Use a SIMD kernel when the target supports one
+//? ------------------------------------------------------------------------------- //
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Name of the kernel used by ADS1220_DecodeBatch ("AVX2", "SSSE3", "NEON" or "Scalar")
+ * @retval Kernel name
+ */
+const char *
+ADS1220_DecodeKernel(void);
+
+/**
+ * @brief  Decodes packed 24-bit samples to sign-extended int32 with the portable scalar kernel
+ * @param  RawData:     Pointer Of packed samples (3 * Count bytes)
+ * @param  ADCSample:   Pointer Of output ADC values (Count elements)
+ * @param  Count:       Number of samples
+ * @retval None
+ */
+void
+ADS1220_DecodeBatchScalar(const uint8_t *RawData, int32_t *ADCSample, uint32_t Count);
+
+/**
+ * @brief  Decodes packed 24-bit samples to sign-extended int32 with the fastest kernel of the target
+ * @param  RawData:     Pointer Of packed samples (3 * Count bytes)
+ * @param  ADCSample:   Pointer Of output ADC values (Count elements)
+ * @param  Count:       Number of samples
+ * @retval None
+ */
+void
+ADS1220_DecodeBatch(const uint8_t *RawData, int32_t *ADCSample, uint32_t Count);
+
+/**
+ * @brief  Decodes packed 24-bit samples straight to scaled float: Output = ADCvalue * Scale
+ * @note   E.g. Scale = VREF / Gain / 0x7FFFFF gives Volt (Same as ADCValueToVoltage).
+ * @param  RawData:     Pointer Of packed samples (3 * Count bytes)
+ * @param  Output:      Pointer Of output values (Count elements)
+ * @param  Count:       Number of samples
+ * @param  Scale:       Output units per ADC code
+ * @retval None
+ */
+void
+ADS1220_DecodeBatchFloat(const uint8_t *RawData, float *Output, uint32_t Count, float Scale);
+
+/**
+ * @brief  Decodes packed 24-bit samples straight to fixed-point values (See ADS1220_Fixed.h)
+ * @param  RawData:     Pointer Of packed samples (3 * Count bytes)
+ * @param  Output:      Pointer Of output values (Count elements)
+ * @param  Count:       Number of samples
+ * @param  Scale:       Pointer Of Scale
+ * @retval None
+ */
+void
+ADS1220_DecodeBatchFixed(const uint8_t *RawData, int32_t *Output, uint32_t Count, const ADS1220_FixedScale_t *Scale);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
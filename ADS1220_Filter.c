@@ -0,0 +1,347 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_Filter.c
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Streaming filters and decimation of ADS1220 samples
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Private Includes -------------------------------------------------------------- //
+#include "ADS1220_Filter.h"
+#include <math.h>
+#include <string.h>
+
+//* Private Defines and Macros ---------------------------------------------------- //
+#define ADS1220_FILTER_PI           3.14159265358979f
+#define ADS1220_FILTER_TO_COEF(x)   ((int32_t)lroundf((x) * (float)(1UL << ADS1220_FILTER_COEF_SHIFT)))
+
+/**
+ *! ==================================================================================
+ *!                          ##### Private Functions #####
+ *! ==================================================================================
+ **/
+
+// Notch coefficients (Audio EQ Cookbook), normalized to a0 = 1: b = {b0, b1, b2}, a = {a1, a2}
+static bool
+ADS1220_NotchDesign (float SampleRate, float Frequency, float Q, float *b, float *a)
+{
+  if (SampleRate <= 0.0f || Frequency <= 0.0f || Frequency >= SampleRate / 2.0f || Q <= 0.0f) return false;
+
+  float w0 = 2.0f * ADS1220_FILTER_PI * Frequency / SampleRate;
+  float Alpha = sinf(w0) / (2.0f * Q);
+  float a0 = 1.0f + Alpha;
+
+  b[0] = 1.0f / a0;
+  b[1] = -2.0f * cosf(w0) / a0;
+  b[2] = 1.0f / a0;
+  a[0] = b[1];
+  a[1] = (1.0f - Alpha) / a0;
+  return true;
+};
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes a moving average
+ * @param  Average:     Pointer Of Moving Average
+ * @param  Buffer:      Pointer Of history array (Length elements)
+ * @param  Length:      Number of averaged samples
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_MovingAverageInit(ADS1220_MovingAverage_t *Average, int32_t *Buffer, uint16_t Length)
+{
+  if (!Buffer || !Length) return false;
+  Average->Buffer = Buffer;
+  Average->Length = Length;
+  Average->Index = 0;
+  Average->Fill = 0;
+  Average->Sum = 0;
+  return true;
+}
+
+/**
+ * @brief  Adds one sample to a moving average
+ * @param  Average:     Pointer Of Moving Average
+ * @param  Sample:      New sample
+ * @retval Average of the last Length samples (Of the samples so far before the window is full)
+ */
+int32_t
+ADS1220_MovingAverageUpdate(ADS1220_MovingAverage_t *Average, int32_t Sample)
+{
+  if (Average->Fill == Average->Length) Average->Sum -= Average->Buffer[Average->Index];
+  else Average->Fill++;
+  Average->Buffer[Average->Index] = Sample;
+  Average->Sum += Sample;
+  if (++Average->Index == Average->Length) Average->Index = 0;
+  return (int32_t)(Average->Sum / Average->Fill);
+}
+
+/**
+ * @brief  Initializes a CIC decimator
+ * @param  CIC:         Pointer Of CIC decimator
+ * @param  Order:       Number of stages (1 - ADS1220_FILTER_CIC_ORDER_MAX)
+ * @param  Decimation:  Decimation ratio (Decimation ^ Order * 2^23 must fit int64)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_CICInit(ADS1220_CIC_t *CIC, uint8_t Order, uint16_t Decimation)
+{
+  if (!Order || Order > ADS1220_FILTER_CIC_ORDER_MAX || !Decimation) return false;
+  memset(CIC, 0, sizeof(*CIC));
+  CIC->Order = Order;
+  CIC->Decimation = Decimation;
+  CIC->Gain = 1;
+  for (uint8_t i = 0; i < Order; i++)
+  {
+    if (CIC->Gain > (INT64_MAX >> 24) / Decimation) return false;
+    CIC->Gain *= Decimation;
+  }
+  return true;
+}
+
+/**
+ * @brief  Adds one sample to a CIC decimator
+ * @param  CIC:         Pointer Of CIC decimator
+ * @param  Sample:      New sample
+ * @param  Output:      Pointer Of decimated output
+ * @retval true: Output is written (Every Decimation samples)
+ */
+bool
+ADS1220_CICUpdate(ADS1220_CIC_t *CIC, int32_t Sample, int32_t *Output)
+{
+  uint64_t Value = (uint64_t)(int64_t)Sample;
+
+  for (uint8_t i = 0; i < CIC->Order; i++)
+    Value = CIC->Integrator[i] += Value;
+  if (++CIC->Count < CIC->Decimation) return false;
+  CIC->Count = 0;
+
+  for (uint8_t i = 0; i < CIC->Order; i++)
+  {
+    uint64_t Previous = CIC->Comb[i];
+    CIC->Comb[i] = Value;
+    Value -= Previous;
+  }
+  *Output = (int32_t)((int64_t)Value / CIC->Gain);
+  return true;
+}
+
+/**
+ * @brief  Initializes a fixed-point notch filter
+ * @param  Biquad:      Pointer Of Biquad
+ * @param  SampleRate:  Sample rate in Hz
+ * @param  Frequency:   Notch frequency in Hz
+ * @param  Q:           Quality factor (Frequency / -3dB bandwidth, E.g. 2)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_BiquadNotchInit(ADS1220_Biquad_t *Biquad, float SampleRate, float Frequency, float Q)
+{
+  float b[3], a[2];
+
+  if (!ADS1220_NotchDesign(SampleRate, Frequency, Q, b, a)) return false;
+  memset(Biquad, 0, sizeof(*Biquad));
+  Biquad->b0 = ADS1220_FILTER_TO_COEF(b[0]);
+  Biquad->b1 = ADS1220_FILTER_TO_COEF(b[1]);
+  Biquad->b2 = ADS1220_FILTER_TO_COEF(b[2]);
+  Biquad->a1 = ADS1220_FILTER_TO_COEF(a[0]);
+  Biquad->a2 = ADS1220_FILTER_TO_COEF(a[1]);
+  return true;
+}
+
+/**
+ * @brief  Filters one sample with a fixed-point biquad
+ * @param  Biquad:      Pointer Of Biquad
+ * @param  Sample:      New sample
+ * @retval Filtered sample
+ */
+int32_t
+ADS1220_BiquadUpdate(ADS1220_Biquad_t *Biquad, int32_t Sample)
+{
+  int64_t Accumulator = (int64_t)Biquad->b0 * Sample + (int64_t)Biquad->b1 * Biquad->x1 + (int64_t)Biquad->b2 * Biquad->x2
+                      - (int64_t)Biquad->a1 * Biquad->y1 - (int64_t)Biquad->a2 * Biquad->y2;
+  int32_t Output = (int32_t)((Accumulator + ((int64_t)1 << (ADS1220_FILTER_COEF_SHIFT - 1))) >> ADS1220_FILTER_COEF_SHIFT);
+
+  Biquad->x2 = Biquad->x1;
+  Biquad->x1 = Sample;
+  Biquad->y2 = Biquad->y1;
+  Biquad->y1 = Output;
+  return Output;
+}
+
+/**
+ * @brief  Initializes a float notch filter
+ * @param  Biquad:      Pointer Of Biquad
+ * @param  SampleRate:  Sample rate in Hz
+ * @param  Frequency:   Notch frequency in Hz
+ * @param  Q:           Quality factor (Frequency / -3dB bandwidth, E.g. 2)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_BiquadFloatNotchInit(ADS1220_BiquadFloat_t *Biquad, float SampleRate, float Frequency, float Q)
+{
+  float b[3], a[2];
+
+  if (!ADS1220_NotchDesign(SampleRate, Frequency, Q, b, a)) return false;
+  Biquad->b0 = b[0];
+  Biquad->b1 = b[1];
+  Biquad->b2 = b[2];
+  Biquad->a1 = a[0];
+  Biquad->a2 = a[1];
+  Biquad->z1 = 0.0f;
+  Biquad->z2 = 0.0f;
+  return true;
+}
+
+/**
+ * @brief  Filters one sample with a float biquad
+ * @param  Biquad:      Pointer Of Biquad
+ * @param  Sample:      New sample
+ * @retval Filtered sample
+ */
+float
+ADS1220_BiquadFloatUpdate(ADS1220_BiquadFloat_t *Biquad, float Sample)
+{
+  float Output = Biquad->b0 * Sample + Biquad->z1;
+  Biquad->z1 = Biquad->b1 * Sample - Biquad->a1 * Output + Biquad->z2;
+  Biquad->z2 = Biquad->b2 * Sample - Biquad->a2 * Output;
+  return Output;
+}
+
+/**
+ * @brief  Initializes a notch bank
+ * @param  Bank:        Pointer Of Notch Bank
+ * @param  SampleRate:  Sample rate in Hz
+ * @param  Frequencies: Pointer Of notch frequencies in Hz (E.g. {50, 60})
+ * @param  Count:       Number of notches (1 - ADS1220_FILTER_NOTCH_MAX)
+ * @param  Q:           Quality factor of every notch
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_NotchBankInit(ADS1220_NotchBank_t *Bank, float SampleRate, const float *Frequencies, uint8_t Count, float Q)
+{
+  if (!Count || Count > ADS1220_FILTER_NOTCH_MAX) return false;
+  for (uint8_t i = 0; i < Count; i++)
+    if (!ADS1220_BiquadNotchInit(&Bank->Stage[i], SampleRate, Frequencies[i], Q)) return false;
+  Bank->Count = Count;
+  return true;
+}
+
+/**
+ * @brief  Filters one sample with every notch of a bank
+ * @param  Bank:        Pointer Of Notch Bank
+ * @param  Sample:      New sample
+ * @retval Filtered sample
+ */
+int32_t
+ADS1220_NotchBankUpdate(ADS1220_NotchBank_t *Bank, int32_t Sample)
+{
+  for (uint8_t i = 0; i < Bank->Count; i++)
+    Sample = ADS1220_BiquadUpdate(&Bank->Stage[i], Sample);
+  return Sample;
+}
+
+/**
+ * @brief  Initializes a median spike rejector
+ * @param  Median:      Pointer Of Median
+ * @param  Window:      Number of samples (Odd, 1 - ADS1220_FILTER_MEDIAN_MAX)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_MedianInit(ADS1220_Median_t *Median, uint8_t Window)
+{
+  if (!(Window & 0x01) || Window > ADS1220_FILTER_MEDIAN_MAX) return false;
+  memset(Median, 0, sizeof(*Median));
+  Median->Window = Window;
+  return true;
+}
+
+/**
+ * @brief  Adds one sample to a median spike rejector
+ * @param  Median:      Pointer Of Median
+ * @param  Sample:      New sample
+ * @retval Median of the last Window samples
+ */
+int32_t
+ADS1220_MedianUpdate(ADS1220_Median_t *Median, int32_t Sample)
+{
+  uint8_t Position;
+
+  // Remove the oldest sample from the sorted window
+  if (Median->Fill == Median->Window)
+  {
+    for (Position = 0; Median->Sorted[Position] != Median->History[Median->Index]; Position++);
+    for (; Position + 1 < Median->Fill; Position++) Median->Sorted[Position] = Median->Sorted[Position + 1];
+    Median->Fill--;
+  }
+
+  // Insert the new one
+  for (Position = Median->Fill; Position && Median->Sorted[Position - 1] > Sample; Position--)
+    Median->Sorted[Position] = Median->Sorted[Position - 1];
+  Median->Sorted[Position] = Sample;
+  Median->Fill++;
+
+  Median->History[Median->Index] = Sample;
+  if (++Median->Index == Median->Window) Median->Index = 0;
+  return Median->Sorted[(Median->Fill - 1) / 2];
+}
+
+/**
+ * @brief  Passes one sample through a filter pipeline
+ * @param  Filter:      Pointer Of Filter
+ * @param  Sample:      New sample
+ * @param  Output:      Pointer Of filtered output
+ * @retval true: Output is written (Every sample, or every Decimation samples if CIC is used)
+ */
+bool
+ADS1220_FilterUpdate(ADS1220_Filter_t *Filter, int32_t Sample, int32_t *Output)
+{
+  if (Filter->Median)  Sample = ADS1220_MedianUpdate(Filter->Median, Sample);
+  if (Filter->Notch)   Sample = ADS1220_NotchBankUpdate(Filter->Notch, Sample);
+  if (Filter->Average) Sample = ADS1220_MovingAverageUpdate(Filter->Average, Sample);
+  if (Filter->CIC)     return ADS1220_CICUpdate(Filter->CIC, Sample, Output);
+  *Output = Sample;
+  return true;
+}
+
+/**
+ * @brief  Reads conversion data (ADS1220_ReadData) and passes it through a filter pipeline
+ * @note   Call it when DRDY goes LOW in Continuous conversion mode.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Filter:      Pointer Of Filter
+ * @param  Output:      Pointer Of filtered output
+ * @retval true: Output is written
+ */
+bool
+ADS1220_FilterReadData(ADS1220_Handler_t *ADC_Handler, ADS1220_Filter_t *Filter, int32_t *Output)
+{
+  int32_t Sample;
+  ADS1220_ReadData(ADC_Handler, &Sample);
+  return ADS1220_FilterUpdate(Filter, Sample, Output);
+}
@@ -0,0 +1,281 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_Filter.h
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Streaming filters and decimation of ADS1220 samples
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Define to prevent recursive inclusion ---------------------------------------- //
+#ifndef ADS1220_FILTER_H
+#define ADS1220_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//* Includes ---------------------------------------------------------------------- //
+#include "ADS1220.h"
+
+//? User Configurations and Notes ------------------------------------------------- //
+// Every update is O(1) per sample. Float is used only by the Init functions and the Float biquad.
+#define ADS1220_FILTER_MEDIAN_MAX       9    // Maximum window of the median spike rejector (Odd)
+#define ADS1220_FILTER_NOTCH_MAX        4    // Maximum number of notches in a notch bank
+#define ADS1220_FILTER_CIC_ORDER_MAX    4    // Maximum order of the CIC decimator
+#define ADS1220_FILTER_COEF_SHIFT       29   // Fraction bits of fixed-point biquad coefficients (Q2.29)
+//? ------------------------------------------------------------------------------- //
+
+/**
+ ** ==================================================================================
+ **                               ##### Structs #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Moving average over the last Length samples
+ */
+typedef struct
+ADS1220_MovingAverage_s {
+  int32_t *Buffer;                      // Must be initialized - Array of Length elements (See ADS1220_MovingAverageInit)
+  uint16_t Length;
+  uint16_t Index;
+  uint16_t Fill;
+  int64_t  Sum;
+} ADS1220_MovingAverage_t;
+
+/**
+ * @brief  CIC (Cascaded Integrator-Comb) decimator: Order stages, Decimation ratio, unity DC gain
+ * @note   Zeros of the response are at multiples of SampleRate / Decimation (E.g. 2000SPS / 40 rejects 50Hz and harmonics).
+ */
+typedef struct
+ADS1220_CIC_s {
+  uint64_t Integrator[ADS1220_FILTER_CIC_ORDER_MAX]; // Wraps around by design
+  uint64_t Comb[ADS1220_FILTER_CIC_ORDER_MAX];
+  int64_t  Gain;                        // Decimation ^ Order
+  uint16_t Decimation;
+  uint16_t Count;
+  uint8_t  Order;
+} ADS1220_CIC_t;
+
+/**
+ * @brief  Fixed-point biquad (Direct form I, Q2.29 coefficients)
+ */
+typedef struct
+ADS1220_Biquad_s {
+  int32_t  b0, b1, b2, a1, a2;
+  int32_t  x1, x2, y1, y2;
+} ADS1220_Biquad_t;
+
+/**
+ * @brief  Float biquad (Direct form II transposed)
+ */
+typedef struct
+ADS1220_BiquadFloat_s {
+  float    b0, b1, b2, a1, a2;
+  float    z1, z2;
+} ADS1220_BiquadFloat_t;
+
+/**
+ * @brief  Bank of fixed-point notch filters in series (E.g. 50Hz and 60Hz)
+ */
+typedef struct
+ADS1220_NotchBank_s {
+  ADS1220_Biquad_t Stage[ADS1220_FILTER_NOTCH_MAX];
+  uint8_t  Count;
+} ADS1220_NotchBank_t;
+
+/**
+ * @brief  Median spike rejector over the last Window samples
+ */
+typedef struct
+ADS1220_Median_s {
+  int32_t  History[ADS1220_FILTER_MEDIAN_MAX];
+  int32_t  Sorted[ADS1220_FILTER_MEDIAN_MAX];
+  uint8_t  Window;
+  uint8_t  Index;
+  uint8_t  Fill;
+} ADS1220_Median_t;
+
+/**
+ * @brief  Per-channel filter pipeline: Median -> Notch -> Average -> CIC
+ * @note   Set unused stages to NULL.
+ */
+typedef struct
+ADS1220_Filter_s {
+  ADS1220_Median_t        *Median;      // Can be initialized
+  ADS1220_NotchBank_t     *Notch;       // Can be initialized
+  ADS1220_MovingAverage_t *Average;     // Can be initialized
+  ADS1220_CIC_t           *CIC;         // Can be initialized - Output only every Decimation samples
+} ADS1220_Filter_t;
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes a moving average
+ * @param  Average:     Pointer Of Moving Average
+ * @param  Buffer:      Pointer Of history array (Length elements)
+ * @param  Length:      Number of averaged samples
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_MovingAverageInit(ADS1220_MovingAverage_t *Average, int32_t *Buffer, uint16_t Length);
+
+/**
+ * @brief  Adds one sample to a moving average
+ * @param  Average:     Pointer Of Moving Average
+ * @param  Sample:      New sample
+ * @retval Average of the last Length samples (Of the samples so far before the window is full)
+ */
+int32_t
+ADS1220_MovingAverageUpdate(ADS1220_MovingAverage_t *Average, int32_t Sample);
+
+/**
+ * @brief  Initializes a CIC decimator
+ * @param  CIC:         Pointer Of CIC decimator
+ * @param  Order:       Number of stages (1 - ADS1220_FILTER_CIC_ORDER_MAX)
+ * @param  Decimation:  Decimation ratio (Decimation ^ Order * 2^23 must fit int64)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_CICInit(ADS1220_CIC_t *CIC, uint8_t Order, uint16_t Decimation);
+
+/**
+ * @brief  Adds one sample to a CIC decimator
+ * @param  CIC:         Pointer Of CIC decimator
+ * @param  Sample:      New sample
+ * @param  Output:      Pointer Of decimated output
+ * @retval true: Output is written (Every Decimation samples)
+ */
+bool
+ADS1220_CICUpdate(ADS1220_CIC_t *CIC, int32_t Sample, int32_t *Output);
+
+/**
+ * @brief  Initializes a fixed-point notch filter
+ * @param  Biquad:      Pointer Of Biquad
+ * @param  SampleRate:  Sample rate in Hz
+ * @param  Frequency:   Notch frequency in Hz
+ * @param  Q:           Quality factor (Frequency / -3dB bandwidth, E.g. 2)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_BiquadNotchInit(ADS1220_Biquad_t *Biquad, float SampleRate, float Frequency, float Q);
+
+/**
+ * @brief  Filters one sample with a fixed-point biquad
+ * @param  Biquad:      Pointer Of Biquad
+ * @param  Sample:      New sample
+ * @retval Filtered sample
+ */
+int32_t
+ADS1220_BiquadUpdate(ADS1220_Biquad_t *Biquad, int32_t Sample);
+
+/**
+ * @brief  Initializes a float notch filter
+ * @param  Biquad:      Pointer Of Biquad
+ * @param  SampleRate:  Sample rate in Hz
+ * @param  Frequency:   Notch frequency in Hz
+ * @param  Q:           Quality factor (Frequency / -3dB bandwidth, E.g. 2)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_BiquadFloatNotchInit(ADS1220_BiquadFloat_t *Biquad, float SampleRate, float Frequency, float Q);
+
+/**
+ * @brief  Filters one sample with a float biquad
+ * @param  Biquad:      Pointer Of Biquad
+ * @param  Sample:      New sample
+ * @retval Filtered sample
+ */
+float
+ADS1220_BiquadFloatUpdate(ADS1220_BiquadFloat_t *Biquad, float Sample);
+
+/**
+ * @brief  Initializes a notch bank
+ * @param  Bank:        Pointer Of Notch Bank
+ * @param  SampleRate:  Sample rate in Hz
+ * @param  Frequencies: Pointer Of notch frequencies in Hz (E.g. {50, 60})
+ * @param  Count:       Number of notches (1 - ADS1220_FILTER_NOTCH_MAX)
+ * @param  Q:           Quality factor of every notch
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_NotchBankInit(ADS1220_NotchBank_t *Bank, float SampleRate, const float *Frequencies, uint8_t Count, float Q);
+
+/**
+ * @brief  Filters one sample with every notch of a bank
+ * @param  Bank:        Pointer Of Notch Bank
+ * @param  Sample:      New sample
+ * @retval Filtered sample
+ */
+int32_t
+ADS1220_NotchBankUpdate(ADS1220_NotchBank_t *Bank, int32_t Sample);
+
+/**
+ * @brief  Initializes a median spike rejector
+ * @param  Median:      Pointer Of Median
+ * @param  Window:      Number of samples (Odd, 1 - ADS1220_FILTER_MEDIAN_MAX)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_MedianInit(ADS1220_Median_t *Median, uint8_t Window);
+
+/**
+ * @brief  Adds one sample to a median spike rejector
+ * @param  Median:      Pointer Of Median
+ * @param  Sample:      New sample
+ * @retval Median of the last Window samples
+ */
+int32_t
+ADS1220_MedianUpdate(ADS1220_Median_t *Median, int32_t Sample);
+
+/**
+ * @brief  Passes one sample through a filter pipeline
+ * @param  Filter:      Pointer Of Filter
+ * @param  Sample:      New sample
+ * @param  Output:      Pointer Of filtered output
+ * @retval true: Output is written (Every sample, or every Decimation samples if CIC is used)
+ */
+bool
+ADS1220_FilterUpdate(ADS1220_Filter_t *Filter, int32_t Sample, int32_t *Output);
+
+/**
+ * @brief  Reads conversion data (ADS1220_ReadData) and passes it through a filter pipeline
+ * @note   Call it when DRDY goes LOW in Continuous conversion mode.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Filter:      Pointer Of Filter
+ * @param  Output:      Pointer Of filtered output
+ * @retval true: Output is written
+ */
+bool
+ADS1220_FilterReadData(ADS1220_Handler_t *ADC_Handler, ADS1220_Filter_t *Filter, int32_t *Output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,203 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_Fixed.c
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Fixed-point conversion of ADS1220 samples to physical units
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Private Includes -------------------------------------------------------------- //
+#include "ADS1220_Fixed.h"
+
+//* Private Defines and Macros ---------------------------------------------------- //
+#define ADS1220_FIXED_FULL_SCALE    8388607.0   // 0x7FFFFF
+#define ADS1220_FIXED_INT32_MAX     2147483647.0
+#define ADS1220_FIXED_BIAS_MAX      2305843009213693952.0 // 2^61: ADCvalue * Multiplier (< 2^54) + Bias stays in int64
+#define ADS1220_FIXED_ABS(x)        (((x) < 0) ? -(x) : (x))
+#define ADS1220_FIXED_ROUND(x)      ((int64_t)(((x) < 0) ? ((x) - 0.5) : ((x) + 0.5)))
+
+/**
+ *! ==================================================================================
+ *!                          ##### Private Functions #####
+ *! ==================================================================================
+ **/
+
+// Same as ADS1220_FixedInit, in double so the slope keeps full int32 precision
+static bool
+ADS1220_FixedInitScale (ADS1220_FixedScale_t *Scale, double UnitsPerCode, double Offset)
+{
+  double Slope = UnitsPerCode;
+  double Bias = Offset;
+  uint8_t Shift = 0;
+
+  if (Slope == 0.0 || ADS1220_FIXED_ABS(Slope) >= ADS1220_FIXED_INT32_MAX) return false;
+  while (Shift < 62 &&
+         ADS1220_FIXED_ABS(Slope * 2.0) <= ADS1220_FIXED_INT32_MAX &&
+         ADS1220_FIXED_ABS(Bias * 2.0) < ADS1220_FIXED_BIAS_MAX)
+  {
+    Slope *= 2.0;
+    Bias *= 2.0;
+    Shift++;
+  }
+
+  Scale->Multiplier = (int32_t)ADS1220_FIXED_ROUND(Slope);
+  Scale->Shift = Shift;
+  Scale->Bias = ADS1220_FIXED_ROUND(Bias) + (Shift ? ((int64_t)1 << (Shift - 1)) : 0);
+  return true;
+};
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes a scale from a linear transfer function: Output = ADCvalue * UnitsPerCode + Offset
+ * @note   Float is used only here. Shift is chosen for the best precision that keeps the hot path in int64.
+ *         Output must fit int32 for every ADC value (|ADCvalue| <= 0x800000).
+ * @param  Scale:        Pointer Of Scale
+ * @param  UnitsPerCode: Output units per ADC code
+ * @param  Offset:       Output units at ADC value 0
+ * @retval false: UnitsPerCode is 0 or too large (>= 2^31)
+ */
+bool
+ADS1220_FixedInit(ADS1220_FixedScale_t *Scale, float UnitsPerCode, float Offset)
+{
+  return ADS1220_FixedInitScale(Scale, UnitsPerCode, Offset);
+}
+
+/**
+ * @brief  Initializes a scale for voltage (Same as ADCValueToVoltage)
+ * @param  Scale:        Pointer Of Scale
+ * @param  VREF:         Reference voltage in Volt
+ * @param  Gain:         See ADS1220_GainConfig enum
+ * @param  Resolution:   Volt per output unit (e.g. 1e-6f: Output is in microvolts)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_FixedInitVoltage(ADS1220_FixedScale_t *Scale, float VREF, ADS1220_GainConfig_t Gain, float Resolution)
+{
+  if (Resolution <= 0.0f) return false;
+  return ADS1220_FixedInitScale(Scale, VREF / ADS1220_FIXED_FULL_SCALE / (1 << Gain) / Resolution, 0.0);
+}
+
+/**
+ * @brief  Initializes a scale for current through a shunt resistor (Same as ADCValueToCurrent)
+ * @param  Scale:        Pointer Of Scale
+ * @param  Resistance:   Shunt resistance in Ohm
+ * @param  VREF:         Reference voltage in Volt
+ * @param  Gain:         See ADS1220_GainConfig enum
+ * @param  Resolution:   Ampere per output unit (e.g. 1e-6f: Output is in microamperes)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_FixedInitCurrent(ADS1220_FixedScale_t *Scale, float Resistance, float VREF, ADS1220_GainConfig_t Gain, float Resolution)
+{
+  if (Resolution <= 0.0f || Resistance == 0.0f) return false;
+  return ADS1220_FixedInitScale(Scale, VREF / Resistance / ADS1220_FIXED_FULL_SCALE / (1 << Gain) / Resolution, 0.0);
+}
+
+/**
+ * @brief  Initializes a scale for a load cell (Same as ADCValueToWeight)
+ * @param  Scale:        Pointer Of Scale
+ * @param  MaxWeight:    Max weight of the load cell
+ * @param  Sensitivity:  Sensitivity of the load cell in mV/V
+ * @param  Gain:         See ADS1220_GainConfig enum
+ * @param  Resolution:   Weight per output unit (e.g. 0.001f: Output is in grams for MaxWeight in kilograms)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_FixedInitWeight(ADS1220_FixedScale_t *Scale, float MaxWeight, float Sensitivity, ADS1220_GainConfig_t Gain, float Resolution)
+{
+  if (Resolution <= 0.0f || Sensitivity == 0.0f) return false;
+  return ADS1220_FixedInitScale(Scale, MaxWeight / ADS1220_FIXED_FULL_SCALE / Sensitivity / (1 << Gain) / Resolution, 0.0);
+}
+
+/**
+ * @brief  Initializes a scale for a full-scale linear sensor (Same as ADCValueToDisplacement and ADCValueToTemperature)
+ * @param  Scale:        Pointer Of Scale
+ * @param  FullScale:    Sensor value at ADC value 0x7FFFFF
+ * @param  Resolution:   Sensor value per output unit
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_FixedInitFullScale(ADS1220_FixedScale_t *Scale, float FullScale, float Resolution)
+{
+  if (Resolution <= 0.0f) return false;
+  return ADS1220_FixedInitScale(Scale, FullScale / ADS1220_FIXED_FULL_SCALE / Resolution, 0.0);
+}
+
+/**
+ * @brief  Initializes a scale for a ratiometric RTD (Same as ADCValueToTemperatureRTD, linear TCR)
+ * @param  Scale:        Pointer Of Scale
+ * @param  RREF:         Reference resistance in Ohm
+ * @param  R0:           Nominal resistance of RTD at 0C in Ohm
+ * @param  Alpha:        TCR of RTD: (R100 - R0) / (R0 * 100)
+ * @param  Gain:         See ADS1220_GainConfig enum
+ * @param  Resolution:   Celsius per output unit (e.g. 0.001f: Output is in millidegrees)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_FixedInitRTD(ADS1220_FixedScale_t *Scale, float RREF, float R0, float Alpha, ADS1220_GainConfig_t Gain, float Resolution)
+{
+  if (Resolution <= 0.0f || R0 == 0.0f || Alpha == 0.0f) return false;
+  // T = (ADCvalue / 0x7FFFFF * 2 * RREF / Gain / R0 - 1) / Alpha
+  return ADS1220_FixedInitScale(Scale, 2.0 * RREF / ADS1220_FIXED_FULL_SCALE / (1 << Gain) / R0 / Alpha / Resolution,
+                                -1.0 / Alpha / Resolution);
+}
+
+/**
+ * @brief  Converts an array of samples with one scale
+ * @param  Scale:        Pointer Of Scale
+ * @param  ADCSample:    Pointer Of input ADC values
+ * @param  Output:       Pointer Of output values (Can be equal to ADCSample)
+ * @param  Count:        Number of samples
+ * @retval None
+ */
+void
+ADS1220_FixedConvertBatch(const ADS1220_FixedScale_t *Scale, const int32_t *ADCSample, int32_t *Output, uint16_t Count)
+{
+  const int32_t Multiplier = Scale->Multiplier;
+  const int64_t Bias = Scale->Bias;
+  const uint8_t Shift = Scale->Shift;
+
+  for (uint16_t i = 0; i < Count; i++)
+    Output[i] = (int32_t)(((int64_t)ADCSample[i] * Multiplier + Bias) >> Shift);
+}
+
+/**
+ * @brief  Converts one sample of each channel with its own scale (e.g. the output of ADS1220_ReadAll or ADS1220_ReadSequence)
+ * @param  Scales:       Pointer Of Scales Array (One per channel)
+ * @param  ADCSample:    Pointer Of input ADC values (One per channel)
+ * @param  Output:       Pointer Of output values (Can be equal to ADCSample)
+ * @param  Count:        Number of channels
+ * @retval None
+ */
+void
+ADS1220_FixedConvertChannels(const ADS1220_FixedScale_t *Scales, const int32_t *ADCSample, int32_t *Output, uint8_t Count)
+{
+  for (uint8_t i = 0; i < Count; i++)
+    Output[i] = ADCValueToFixed(ADCSample[i], &Scales[i]);
+}
@@ -0,0 +1,170 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_Fixed.h
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Fixed-point conversion of ADS1220 samples to physical units
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Define to prevent recursive inclusion ---------------------------------------- //
+#ifndef ADS1220_FIXED_H
+#define ADS1220_FIXED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//* Includes ---------------------------------------------------------------------- //
+#include "ADS1220.h"
+
+//* Defines and Macros ------------------------------------------------------------ //
+// Hot path: One multiply, one add and one shift per sample (Rounding and Offset are folded into Bias)
+// Output is in units of the Resolution given to the init function, e.g. Resolution = 1e-6 V gives microvolts
+// Cost: The product of a 24-bit ADC value and a 31-bit Multiplier needs 64 bits. On Cortex-M3/M4/M7 this is one SMLAL plus
+//       a 64-bit shift (about 5 cycles). On Cortex-M0/M0+ (No 32x32->64 multiply) it is an __aeabi_lmul call plus an inline
+//       64-bit shift (about 40 cycles), still several times cheaper than the soft-float macros. A 32x32->32 product would leave
+//       Multiplier 8 bits (0.4% error), so the precision is kept and the 64-bit path is used on every core.
+#define ADCValueToFixed(x/*ADCvalue*/, s/*Pointer Of ADS1220_FixedScale_t*/) \
+  ((int32_t)(((int64_t)(x) * (s)->Multiplier + (s)->Bias) >> (s)->Shift))
+
+/**
+ ** ==================================================================================
+ **                               ##### Structs #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Precomputed scale and offset of one channel: Output = (ADCvalue * Multiplier + Bias) >> Shift
+ * @note   Initialize it once with one of the ADS1220_FixedInit functions.
+ */
+typedef struct
+ADS1220_FixedScale_s {
+  int32_t  Multiplier;                  // Slope in Q(Shift)
+  uint8_t  Shift;                       // Fraction bits of Multiplier and Bias
+  int64_t  Bias;                        // Offset in Q(Shift) plus rounding
+} ADS1220_FixedScale_t;
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes a scale from a linear transfer function: Output = ADCvalue * UnitsPerCode + Offset
+ * @note   Float is used only here. Shift is chosen for the best precision that keeps the hot path in int64.
+ *         Output must fit int32 for every ADC value (|ADCvalue| <= 0x800000).
+ * @param  Scale:        Pointer Of Scale
+ * @param  UnitsPerCode: Output units per ADC code
+ * @param  Offset:       Output units at ADC value 0
+ * @retval false: UnitsPerCode is 0 or too large (>= 2^31)
+ */
+bool
+ADS1220_FixedInit(ADS1220_FixedScale_t *Scale, float UnitsPerCode, float Offset);
+
+/**
+ * @brief  Initializes a scale for voltage (Same as ADCValueToVoltage)
+ * @param  Scale:        Pointer Of Scale
+ * @param  VREF:         Reference voltage in Volt
+ * @param  Gain:         See ADS1220_GainConfig enum
+ * @param  Resolution:   Volt per output unit (e.g. 1e-6f: Output is in microvolts)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_FixedInitVoltage(ADS1220_FixedScale_t *Scale, float VREF, ADS1220_GainConfig_t Gain, float Resolution);
+
+/**
+ * @brief  Initializes a scale for current through a shunt resistor (Same as ADCValueToCurrent)
+ * @param  Scale:        Pointer Of Scale
+ * @param  Resistance:   Shunt resistance in Ohm
+ * @param  VREF:         Reference voltage in Volt
+ * @param  Gain:         See ADS1220_GainConfig enum
+ * @param  Resolution:   Ampere per output unit (e.g. 1e-6f: Output is in microamperes)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_FixedInitCurrent(ADS1220_FixedScale_t *Scale, float Resistance, float VREF, ADS1220_GainConfig_t Gain, float Resolution);
+
+/**
+ * @brief  Initializes a scale for a load cell (Same as ADCValueToWeight)
+ * @param  Scale:        Pointer Of Scale
+ * @param  MaxWeight:    Max weight of the load cell
+ * @param  Sensitivity:  Sensitivity of the load cell in mV/V
+ * @param  Gain:         See ADS1220_GainConfig enum
+ * @param  Resolution:   Weight per output unit (e.g. 0.001f: Output is in grams for MaxWeight in kilograms)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_FixedInitWeight(ADS1220_FixedScale_t *Scale, float MaxWeight, float Sensitivity, ADS1220_GainConfig_t Gain, float Resolution);
+
+/**
+ * @brief  Initializes a scale for a full-scale linear sensor (Same as ADCValueToDisplacement and ADCValueToTemperature)
+ * @param  Scale:        Pointer Of Scale
+ * @param  FullScale:    Sensor value at ADC value 0x7FFFFF
+ * @param  Resolution:   Sensor value per output unit
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_FixedInitFullScale(ADS1220_FixedScale_t *Scale, float FullScale, float Resolution);
+
+/**
+ * @brief  Initializes a scale for a ratiometric RTD (Same as ADCValueToTemperatureRTD, linear TCR)
+ * @param  Scale:        Pointer Of Scale
+ * @param  RREF:         Reference resistance in Ohm
+ * @param  R0:           Nominal resistance of RTD at 0C in Ohm
+ * @param  Alpha:        TCR of RTD: (R100 - R0) / (R0 * 100)
+ * @param  Gain:         See ADS1220_GainConfig enum
+ * @param  Resolution:   Celsius per output unit (e.g. 0.001f: Output is in millidegrees)
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_FixedInitRTD(ADS1220_FixedScale_t *Scale, float RREF, float R0, float Alpha, ADS1220_GainConfig_t Gain, float Resolution);
+
+/**
+ * @brief  Converts an array of samples with one scale
+ * @param  Scale:        Pointer Of Scale
+ * @param  ADCSample:    Pointer Of input ADC values
+ * @param  Output:       Pointer Of output values (Can be equal to ADCSample)
+ * @param  Count:        Number of samples
+ * @retval None
+ */
+void
+ADS1220_FixedConvertBatch(const ADS1220_FixedScale_t *Scale, const int32_t *ADCSample, int32_t *Output, uint16_t Count);
+
+/**
+ * @brief  Converts one sample of each channel with its own scale (e.g. the output of ADS1220_ReadAll or ADS1220_ReadSequence)
+ * @param  Scales:       Pointer Of Scales Array (One per channel)
+ * @param  ADCSample:    Pointer Of input ADC values (One per channel)
+ * @param  Output:       Pointer Of output values (Can be equal to ADCSample)
+ * @param  Count:        Number of channels
+ * @retval None
+ */
+void
+ADS1220_FixedConvertChannels(const ADS1220_FixedScale_t *Scales, const int32_t *ADCSample, int32_t *Output, uint8_t Count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
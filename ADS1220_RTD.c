@@ -0,0 +1,180 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_RTD.c
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Ratiometric RTD measurement with IDAC chopping
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Private Includes -------------------------------------------------------------- //
+#include "ADS1220_RTD.h"
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Fills a Callendar-Van Dusen table
+ * @note   R(T) / R0 = 1 + A*T + B*T^2 (T >= 0C) | 1 + A*T + B*T^2 + C*(T - 100)*T^3 (T < 0C)
+ * @param  Table:       Pointer Of Table
+ * @param  A, B, C:     Callendar-Van Dusen coefficients (E.g. ADS1220_RTD_CVD_A, ADS1220_RTD_CVD_B, ADS1220_RTD_CVD_C)
+ * @retval None
+ */
+void
+ADS1220_RTDTableInit(ADS1220_RTDTable_t *Table, float A, float B, float C)
+{
+  for (uint16_t i = 0; i < ADS1220_RTD_TABLE_SIZE; i++)
+  {
+    float T = (float)(ADS1220_RTD_TABLE_MIN_C + (int32_t)i * ADS1220_RTD_TABLE_STEP_C);
+    float Ratio = 1.0f + A * T + B * T * T;
+    if (T < 0.0f) Ratio += C * (T - 100.0f) * T * T * T;
+    Table->Ratio[i] = Ratio;
+  }
+}
+
+/**
+ * @brief  Converts R / R0 to temperature (Binary search and linear interpolation)
+ * @note   Outside the table the first or last segment is extrapolated.
+ * @param  Table:       Pointer Of Table
+ * @param  Ratio:       Resistance / R0
+ * @retval Temperature in C
+ */
+float
+ADS1220_RTDTableLookup(const ADS1220_RTDTable_t *Table, float Ratio)
+{
+  uint16_t Low = 0, High = ADS1220_RTD_TABLE_SIZE - 1;
+  while (High - Low > 1)
+  {
+    uint16_t Middle = (Low + High) / 2;
+    if (Table->Ratio[Middle] <= Ratio) Low = Middle;
+    else High = Middle;
+  }
+  return (float)ADS1220_RTD_TABLE_MIN_C + (float)ADS1220_RTD_TABLE_STEP_C *
+         ((float)Low + (Ratio - Table->Ratio[Low]) / (Table->Ratio[High] - Table->Ratio[Low]));
+}
+
+/**
+ * @brief  Initializes an RTD measurement
+ * @param  RTD:         Pointer Of RTD State
+ * @param  Config:      Pointer Of RTD Wiring | Must stay valid while the RTD is used
+ * @retval false: Invalid configuration (E.g. 3-wire without Compensation, RREF or R0 is not positive)
+ */
+bool
+ADS1220_RTDInit(ADS1220_RTD_t *RTD, const ADS1220_RTDConfig_t *Config)
+{
+  if (!Config->Table || Config->RREF <= 0.0f || Config->R0 <= 0.0f || Config->Excitation == Disabled) return false;
+  if (Config->Wires == RTD3Wire && Config->Compensation == Disabled) return false;
+  RTD->Config = Config;
+  RTD->Chop = (Config->Compensation != Disabled);
+  RTD->OhmPerCode = Config->RREF * (Config->Wires == RTD3Wire ? 2.0f : 1.0f) / (float)(1UL << Config->Gain) / 8388608.0f;
+  RTD->Resistance = 0.0f;
+  RTD->Last = 0;
+  RTD->Phase = 0;
+  RTD->Fill = 0;
+  return true;
+}
+
+/**
+ * @brief  Configures ADS1220 for an RTD (Input, gain, reference and IDACs) and starts the first conversion
+ * @note   Data rate, operating mode and conversion mode are kept.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  RTD:         Pointer Of RTD State
+ * @retval None
+ */
+void
+ADS1220_RTDStart(ADS1220_Handler_t *ADC_Handler, ADS1220_RTD_t *RTD)
+{
+  const ADS1220_RTDConfig_t *Config = RTD->Config;
+  ADS1220_ConversionTiming_t Timing;
+
+  for (uint8_t Phase = 0; Phase < 2; Phase++)
+  {
+    ADS1220_IDACrouting_t IDAC1 = Phase ? Config->Compensation : Config->Excitation;
+    ADS1220_IDACrouting_t IDAC2 = Phase ? Config->Excitation : Config->Compensation;
+    uint8_t *Image = RTD->Image[Phase];
+    Image[0] = (Config->InputMux << 4) | (Config->Gain << 1);
+    Image[1] = ADC_Handler->RegShadow[1];
+    Image[2] = (Config->VoltageRef << 6) | (ADC_Handler->RegShadow[2] & 0x38) | Config->IDACcurrent;
+    Image[3] = (IDAC1 << 5) | (IDAC2 << 2) | (ADC_Handler->RegShadow[3] & 0x03);
+  }
+  ADS1220_GetConversionTiming((ADS1220_DataRate_t)(RTD->Image[0][1] >> 5), (ADS1220_OperatingMode_t)((RTD->Image[0][1] >> 3) & 0x03),
+                              ADS1220_FCLK_HZ, &Timing);
+  RTD->Expected_US = Timing.FirstConversion_US;
+  RTD->Phase = 0;
+  RTD->Fill = 0;
+  ADS1220_WriteImage(ADC_Handler, RTD->Image[0]);
+  ADS1220_StartSync(ADC_Handler);
+}
+
+/**
+ * @brief  Reads one conversion and writes the next IDAC routing in the same frame
+ * @note   Call it when DRDY goes LOW. In Single-shot mode the next conversion is started.
+ * @param  ADC_Handler:   Pointer Of Library Handler
+ * @param  RTD:           Pointer Of RTD State
+ * @param  Temperature_C: Pointer Of Temperature in C
+ * @retval true: Temperature is written (Every conversion, from the second one when chopping)
+ */
+bool
+ADS1220_RTDOnDRDY(ADS1220_Handler_t *ADC_Handler, ADS1220_RTD_t *RTD, float *Temperature_C)
+{
+  int32_t Sample;
+  float Code;
+
+  if (RTD->Chop) RTD->Phase ^= 1;
+  ADS1220_ReadDataWriteImage(ADC_Handler, RTD->Image[RTD->Phase], &Sample);
+  if (ADS1220_GetPowerState(ADC_Handler) != StateContinuous) ADS1220_StartSync(ADC_Handler);
+
+  if (RTD->Fill < 2) RTD->Fill++;
+  if (RTD->Chop)
+  {
+    int32_t Last = RTD->Last;
+    RTD->Last = Sample;
+    if (RTD->Fill < 2) return false;
+    Code = 0.5f * ((float)Sample + (float)Last); // One conversion of each IDAC routing
+  }
+  else Code = (float)Sample;
+
+  RTD->Resistance = Code * RTD->OhmPerCode;
+  *Temperature_C = ADS1220_RTDTableLookup(RTD->Config->Table, RTD->Resistance / RTD->Config->R0);
+  return true;
+}
+
+/**
+ * @brief  Waits for the next temperature (Blocking, see ADS1220_WaitDRDY)
+ * @param  ADC_Handler:   Pointer Of Library Handler
+ * @param  RTD:           Pointer Of RTD State
+ * @param  Temperature_C: Pointer Of Temperature in C
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time
+ */
+ADS1220_Result_t
+ADS1220_RTDRead(ADS1220_Handler_t *ADC_Handler, ADS1220_RTD_t *RTD, float *Temperature_C)
+{
+  do
+  {
+    if (ADS1220_WaitDRDY(ADC_Handler, RTD->Expected_US) != ResultOK) return ResultTimeout;
+  } while (!ADS1220_RTDOnDRDY(ADC_Handler, RTD, Temperature_C));
+  return ResultOK;
+}
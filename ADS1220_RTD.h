@@ -0,0 +1,189 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_RTD.h
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Ratiometric RTD measurement with IDAC chopping
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Define to prevent recursive inclusion ---------------------------------------- //
+#ifndef ADS1220_RTD_H
+#define ADS1220_RTD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//* Includes ---------------------------------------------------------------------- //
+#include "ADS1220.h"
+
+//? User Configurations and Notes ------------------------------------------------- //
+// The reference resistor is in series with the RTD (Low side), so IDAC drift cancels: R_RTD = Code * RREF * n / (Gain * 2^23)
+// n = 2 for 3-wire (Both IDAC currents return through RREF) and n = 1 for 2-wire and 4-wire.
+#define ADS1220_RTD_TABLE_MIN_C         -200 // First temperature of the Callendar-Van Dusen table in C
+#define ADS1220_RTD_TABLE_MAX_C         850  // Last temperature of the Callendar-Van Dusen table in C
+#define ADS1220_RTD_TABLE_STEP_C        10   // Temperature step of the table in C (10C: Interpolation error < 0.011C for platinum RTDs)
+#define ADS1220_RTD_TABLE_SIZE          ((ADS1220_RTD_TABLE_MAX_C - ADS1220_RTD_TABLE_MIN_C) / ADS1220_RTD_TABLE_STEP_C + 1)
+
+// IEC 60751 platinum RTD coefficients (Callendar-Van Dusen)
+#define ADS1220_RTD_CVD_A               3.9083e-3f
+#define ADS1220_RTD_CVD_B               -5.775e-7f
+#define ADS1220_RTD_CVD_C               -4.183e-12f
+//? ------------------------------------------------------------------------------- //
+
+/**
+ ** ==================================================================================
+ **                                ##### Enums #####
+ ** ==================================================================================
+ **/
+
+typedef enum
+ADS1220_RTDWires_e {
+  RTD2Wire = 2,
+  RTD3Wire = 3, // Needs a lead compensation current (Compensation)
+  RTD4Wire = 4
+} ADS1220_RTDWires_t;
+
+/**
+ ** ==================================================================================
+ **                               ##### Structs #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Callendar-Van Dusen table: R(T) / R0 at ADS1220_RTD_TABLE_MIN_C + i * ADS1220_RTD_TABLE_STEP_C
+ * @note   One table can be shared by all RTDs of the same type.
+ */
+typedef struct
+ADS1220_RTDTable_s {
+  float Ratio[ADS1220_RTD_TABLE_SIZE];
+} ADS1220_RTDTable_t;
+
+/**
+ * @brief  RTD wiring
+ */
+typedef struct
+ADS1220_RTDConfig_s {
+  ADS1220_RTDWires_t       Wires;        // See ADS1220_RTDWires enum
+  ADS1220_InputMuxConfig_t InputMux;     // RTD voltage input | See ADS1220_InputMuxConfig enum
+  ADS1220_GainConfig_t     Gain;         // See ADS1220_GainConfig enum
+  ADS1220_VoltageRef_t     VoltageRef;   // Input of the reference resistor: ExternalREF0 or ExternalREF1
+  ADS1220_IDACcurrent_t    IDACcurrent;  // See ADS1220_IDACcurrent enum
+  ADS1220_IDACrouting_t    Excitation;   // Pin of the RTD excitation current
+  ADS1220_IDACrouting_t    Compensation; // 3-wire: Pin of the lead compensation current | Disabled: 2-wire and 4-wire
+  float                    RREF;         // Reference resistor in Ohm
+  float                    R0;           // RTD resistance at 0C in Ohm (E.g. 100 for PT100)
+  const ADS1220_RTDTable_t *Table;       // Must be initialized (See ADS1220_RTDTableInit)
+} ADS1220_RTDConfig_t;
+
+/**
+ * @brief  RTD measurement state
+ * @note   With a Compensation current, IDAC1 and IDAC2 swap pins on every conversion. The swap is written in the
+ *         same frame that reads the previous conversion, and every output is the mean of the last two conversions
+ *         (One of each routing), so the IDAC mismatch cancels at the full data rate.
+ */
+typedef struct
+ADS1220_RTD_s {
+  uint8_t  Image[2][4];                  // Register images of both IDAC routings (Built by ADS1220_RTDStart)
+  const ADS1220_RTDConfig_t *Config;
+  float    OhmPerCode;
+  float    Resistance;                   // Last resistance in Ohm
+  int32_t  Last;                         // Previous conversion (Other routing)
+  uint32_t Expected_US;                  // Conversion time after a register write
+  uint8_t  Phase;                        // IDAC routing of the running conversion
+  uint8_t  Fill;                         // Conversions read since ADS1220_RTDStart (Up to 2)
+  bool     Chop;
+} ADS1220_RTD_t;
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Fills a Callendar-Van Dusen table
+ * @note   R(T) / R0 = 1 + A*T + B*T^2 (T >= 0C) | 1 + A*T + B*T^2 + C*(T - 100)*T^3 (T < 0C)
+ * @param  Table:       Pointer Of Table
+ * @param  A, B, C:     Callendar-Van Dusen coefficients (E.g. ADS1220_RTD_CVD_A, ADS1220_RTD_CVD_B, ADS1220_RTD_CVD_C)
+ * @retval None
+ */
+void
+ADS1220_RTDTableInit(ADS1220_RTDTable_t *Table, float A, float B, float C);
+
+/**
+ * @brief  Converts R / R0 to temperature (Binary search and linear interpolation)
+ * @note   Outside the table the first or last segment is extrapolated.
+ * @param  Table:       Pointer Of Table
+ * @param  Ratio:       Resistance / R0
+ * @retval Temperature in C
+ */
+float
+ADS1220_RTDTableLookup(const ADS1220_RTDTable_t *Table, float Ratio);
+
+/**
+ * @brief  Initializes an RTD measurement
+ * @param  RTD:         Pointer Of RTD State
+ * @param  Config:      Pointer Of RTD Wiring | Must stay valid while the RTD is used
+ * @retval false: Invalid configuration (E.g. 3-wire without Compensation, RREF or R0 is not positive)
+ */
+bool
+ADS1220_RTDInit(ADS1220_RTD_t *RTD, const ADS1220_RTDConfig_t *Config);
+
+/**
+ * @brief  Configures ADS1220 for an RTD (Input, gain, reference and IDACs) and starts the first conversion
+ * @note   Data rate, operating mode and conversion mode are kept.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  RTD:         Pointer Of RTD State
+ * @retval None
+ */
+void
+ADS1220_RTDStart(ADS1220_Handler_t *ADC_Handler, ADS1220_RTD_t *RTD);
+
+/**
+ * @brief  Reads one conversion and writes the next IDAC routing in the same frame
+ * @note   Call it when DRDY goes LOW. In Single-shot mode the next conversion is started.
+ * @param  ADC_Handler:   Pointer Of Library Handler
+ * @param  RTD:           Pointer Of RTD State
+ * @param  Temperature_C: Pointer Of Temperature in C
+ * @retval true: Temperature is written (Every conversion, from the second one when chopping)
+ */
+bool
+ADS1220_RTDOnDRDY(ADS1220_Handler_t *ADC_Handler, ADS1220_RTD_t *RTD, float *Temperature_C);
+
+/**
+ * @brief  Waits for the next temperature (Blocking, see ADS1220_WaitDRDY)
+ * @param  ADC_Handler:   Pointer Of Library Handler
+ * @param  RTD:           Pointer Of RTD State
+ * @param  Temperature_C: Pointer Of Temperature in C
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time
+ */
+ADS1220_Result_t
+ADS1220_RTDRead(ADS1220_Handler_t *ADC_Handler, ADS1220_RTD_t *RTD, float *Temperature_C);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1327 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_Sim.c
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Host-side behavioural simulator of ADS1220 and SPI-cost benchmark
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Private Includes -------------------------------------------------------------- //
+#include "ADS1220_Sim.h"
+#include "ADS1220_Fixed.h"
+#include "ADS1220_Decode.h"
+#include "ADS1220_Filter.h"
+#include "ADS1220_RTD.h"
+#include "ADS1220_Thermocouple.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//* Private Defines and Macros ---------------------------------------------------- //
+#define ADS1220_SIM_PI              3.14159265358979f
+#define ADS1220_SIM_FULL_SCALE      8388608.0f  // 2^23
+
+/**
+ ** ==================================================================================
+ **                           ##### Private Variables #####
+ ** ==================================================================================
+ **/
+
+static ADS1220_SimClock_t *ADS1220_SimActiveClock = NULL;
+
+static const float ADS1220_SimDataRates[3][7] = {
+  {20.0f, 45.0f, 90.0f, 175.0f, 330.0f, 600.0f, 1000.0f},  // Normal Mode
+  {5.0f, 11.25f, 22.5f, 44.0f, 82.5f, 150.0f, 250.0f},     // Duty Cycle Mode
+  {40.0f, 90.0f, 180.0f, 350.0f, 660.0f, 1200.0f, 2000.0f} // Turbo Mode
+};
+
+/**
+ *! ==================================================================================
+ *!                          ##### Private Functions #####
+ *! ==================================================================================
+ **/
+
+// Conversion timing of a REG01h value from the library timing model
+static uint64_t
+ADS1220_Sim_Conversion_NS (uint8_t Reg01h, bool First)
+{
+  ADS1220_ConversionTiming_t Timing;
+  ADS1220_GetConversionTiming((ADS1220_DataRate_t)(Reg01h >> 5), (ADS1220_OperatingMode_t)((Reg01h >> 3) & 0x03),
+                              ADS1220_FCLK_HZ, &Timing);
+  return (uint64_t)(First ? Timing.FirstConversion_US : Timing.Period_US) * 1000ULL;
+}
+
+static int32_t
+ADS1220_Sim_Convert (ADS1220_Sim_t *Sim, uint64_t Time_NS)
+{
+  uint8_t Mux  = Sim->ConvReg[0] >> 4;
+  float   Gain = (float)(1 << ((Sim->ConvReg[0] >> 1) & 0x07));
+  float   VREF, Voltage;
+
+  if (Sim->ConvReg[1] & 0x02) // Temperature sensor mode: 14-bit left-justified, 0.03125C per LSB
+    return (int32_t)lroundf(Sim->Temperature_C / 0.03125f) * 1024;
+
+  switch (Sim->ConvReg[2] >> 6)
+  {
+  case 0:  VREF = 2.048f; break;
+  case 1:  VREF = Sim->ExternalREF_V[0]; break;
+  case 2:  VREF = Sim->ExternalREF_V[1]; break;
+  default: VREF = Sim->AVDD_V; break;
+  }
+
+  if (Mux <= P3NAVSS)
+  {
+    const ADS1220_SimInput_t *Input = &Sim->Input[Mux];
+    Voltage = Input->Offset_V + Input->Amplitude_V * sinf(2.0f * ADS1220_SIM_PI * Input->Frequency_Hz * (float)(Time_NS * 1e-9));
+  }
+  else if (Mux == Mode1) { Voltage = Sim->ExternalREF_V[0] / 4.0f; Gain = 1.0f; }
+  else if (Mux == Mode2) { Voltage = Sim->AVDD_V / 4.0f; Gain = 1.0f; }
+  else Voltage = 0.0f;
+
+  float Code = Voltage * Gain / VREF * ADS1220_SIM_FULL_SCALE;
+  if (Code >  8388607.0f) Code =  8388607.0f;
+  if (Code < -8388608.0f) Code = -8388608.0f;
+  return (int32_t)lroundf(Code);
+}
+
+// Finishes every conversion whose end time has passed
+static void
+ADS1220_Sim_Update (ADS1220_Sim_t *Sim)
+{
+  while (Sim->Converting && Sim->Clock->Now_NS >= Sim->ConversionEnd_NS)
+  {
+    if (Sim->DataReady) Sim->Overruns++;
+    Sim->Data = ADS1220_Sim_Convert(Sim, Sim->ConversionEnd_NS);
+    Sim->DataReady = true;
+    Sim->Conversions++;
+    if (Sim->ConvReg[1] & 0x04) Sim->ConversionEnd_NS += ADS1220_Sim_Conversion_NS(Sim->ConvReg[1], false); // Continuous mode
+    else Sim->Converting = false; // Single-shot mode: Enters low-power state
+  }
+}
+
+static void
+ADS1220_Sim_StartConversion (ADS1220_Sim_t *Sim)
+{
+  memcpy(Sim->ConvReg, Sim->Reg, 4);
+  Sim->Converting = true;
+  Sim->DataReady = false;
+  Sim->ConversionEnd_NS = Sim->Clock->Now_NS + ADS1220_Sim_Conversion_NS(Sim->Reg[1], true);
+}
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes a Clock
+ * @note   The Clock becomes the active clock of ADS1220_Sim_Delay_US.
+ * @param  Clock:       Pointer Of Clock
+ * @param  SPIClock_Hz: SPI clock (SCLK) frequency in Hz
+ * @retval None
+ */
+void
+ADS1220_Sim_ClockInit(ADS1220_SimClock_t *Clock, uint32_t SPIClock_Hz)
+{
+  memset(Clock, 0, sizeof(*Clock));
+  Clock->SPIClock_Hz = SPIClock_Hz;
+  ADS1220_SimActiveClock = Clock;
+}
+
+/**
+ * @brief  Resets the cost counters of a Clock (Simulated time keeps running)
+ * @param  Clock:       Pointer Of Clock
+ * @retval None
+ */
+void
+ADS1220_Sim_ClockResetStats(ADS1220_SimClock_t *Clock)
+{
+  Clock->SPI_NS = 0;
+  Clock->Delay_NS = 0;
+  Clock->DRDYWait_NS = 0;
+  Clock->SPIBytes = 0;
+  Clock->CSToggles = 0;
+  Clock->DelayCalls = 0;
+  Clock->Samples = 0;
+}
+
+/**
+ * @brief  Initializes a simulated ADS1220 at power up
+ * @note   All inputs are 0V, external references are 2.5V, AVDD is 3.3V and temperature is 25C.
+ * @param  Sim:         Pointer Of Simulated ADS1220
+ * @param  Clock:       Pointer Of Clock
+ * @retval None
+ */
+void
+ADS1220_Sim_Init(ADS1220_Sim_t *Sim, ADS1220_SimClock_t *Clock)
+{
+  memset(Sim, 0, sizeof(*Sim));
+  Sim->Clock = Clock;
+  Sim->ExternalREF_V[0] = 2.5f;
+  Sim->ExternalREF_V[1] = 2.5f;
+  Sim->AVDD_V = 3.3f;
+  Sim->Temperature_C = 25.0f;
+  Sim->CS = 1;
+}
+
+/**
+ * @brief  Connects a simulated ADS1220 to a Library Handler
+ * @note   Sets Context, ADC_Transfer, ADC_CS_Write, ADC_DRDY_Get, ADC_Delay_US and ADC_GetTime_US.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Sim:         Pointer Of Simulated ADS1220
+ * @retval None
+ */
+void
+ADS1220_Sim_Attach(ADS1220_Handler_t *ADC_Handler, ADS1220_Sim_t *Sim)
+{
+  ADC_Handler->Context = Sim;
+  ADC_Handler->ADC_Transfer = ADS1220_Sim_Transfer;
+  ADC_Handler->ADC_CS_Write = ADS1220_Sim_CS;
+  ADC_Handler->ADC_DRDY_Get = ADS1220_Sim_DRDY;
+  ADC_Handler->ADC_Delay_US = ADS1220_Sim_Delay_US;
+  ADC_Handler->ADC_GetTime_US = ADS1220_Sim_GetTime_US;
+}
+
+/**
+ * @brief  Sets the input waveform of one Input Multiplexer setting
+ * @param  Sim:          Pointer Of Simulated ADS1220
+ * @param  Mux:          See ADS1220_InputMuxConfig enum
+ * @param  Offset_V:     DC level in Volt
+ * @param  Amplitude_V:  Sine amplitude in Volt
+ * @param  Frequency_Hz: Sine frequency in Hz
+ * @retval None
+ */
+void
+ADS1220_Sim_SetInput(ADS1220_Sim_t *Sim, ADS1220_InputMuxConfig_t Mux, float Offset_V, float Amplitude_V, float Frequency_Hz)
+{
+  if (Mux > 15) return;
+  Sim->Input[Mux].Offset_V = Offset_V;
+  Sim->Input[Mux].Amplitude_V = Amplitude_V;
+  Sim->Input[Mux].Frequency_Hz = Frequency_Hz;
+}
+
+/**
+ * @brief  Advances the simulated time
+ * @param  Clock:       Pointer Of Clock
+ * @param  Time_NS:     Time in NanoSecond
+ * @retval None
+ */
+void
+ADS1220_Sim_Advance(ADS1220_SimClock_t *Clock, uint64_t Time_NS)
+{
+  Clock->Now_NS += Time_NS;
+}
+
+/**
+ * @brief  Output data rate of a configuration in SPS
+ * @param  Reg01h:      REG01h value
+ * @retval Output data rate
+ */
+float
+ADS1220_Sim_DataRate(uint8_t Reg01h)
+{
+  uint8_t Mode = (Reg01h >> 3) & 0x03;
+  uint8_t Rate = Reg01h >> 5;
+  if (Mode > TurboMode) Mode = NormalMode;
+  if (Rate > 6) Rate = 6;
+  return ADS1220_SimDataRates[Mode][Rate];
+}
+
+/**
+ * @brief  ADC_Transfer callback of the simulator (Context: Pointer Of Simulated ADS1220)
+ */
+void
+ADS1220_Sim_Transfer(void *Context, const uint8_t *TxData, uint8_t *RxData, uint16_t Length)
+{
+  ADS1220_Sim_t *Sim = (ADS1220_Sim_t *)Context;
+  ADS1220_SimClock_t *Clock = Sim->Clock;
+  uint8_t Response[64] = {0};
+
+  ADS1220_Sim_Update(Sim);
+  if (Length > sizeof(Response)) Length = sizeof(Response);
+
+  // Output (DOUT)
+  if ((TxData[0] & 0xF0) == 0x20)                // RREG
+  {
+    uint8_t Reg = (TxData[0] >> 2) & 0x03, Count = (TxData[0] & 0x03) + 1;
+    for (uint8_t i = 0; i < Count && Reg + i < 4 && i + 1 < Length; i++) Response[i + 1] = Sim->Reg[Reg + i];
+  }
+  else if ((TxData[0] & 0xF0) == 0x10 || Sim->DataReady) // RDATA or direct read after DRDY
+  {
+    uint8_t Start = ((TxData[0] & 0xF0) == 0x10) ? 1 : 0;
+    Response[Start] = (uint8_t)(Sim->Data >> 16);
+    if (Start + 1 < Length) Response[Start + 1] = (uint8_t)(Sim->Data >> 8);
+    if (Start + 2 < Length) Response[Start + 2] = (uint8_t)Sim->Data;
+    if (Sim->DataReady) Clock->Samples++;
+    Sim->DataReady = false;
+  }
+
+  // Input (DIN) command decoder
+  for (uint16_t i = 0; i < Length; )
+  {
+    uint8_t Command = TxData[i];
+    if ((Command & 0xF0) == 0x40)                // WREG
+    {
+      uint8_t Reg = (Command >> 2) & 0x03, Count = (Command & 0x03) + 1;
+      for (uint8_t j = 0; j < Count && i + 1 + j < Length && Reg + j < 4; j++) Sim->Reg[Reg + j] = TxData[i + 1 + j];
+      i += 1 + Count;
+      if (Sim->Converting) ADS1220_Sim_StartConversion(Sim); // Writing a register restarts the ongoing conversion
+    }
+    else if ((Command & 0xF0) == 0x20) i += 1 + (Command & 0x03) + 1; // RREG
+    else if ((Command & 0xF0) == 0x10) i += 4;   // RDATA
+    else
+    {
+      if ((Command & 0xFE) == 0x08) ADS1220_Sim_StartConversion(Sim);   // START/SYNC
+      else if ((Command & 0xFE) == 0x06)                                // RESET
+      {
+        memset(Sim->Reg, 0, 4);
+        Sim->Converting = false;
+        Sim->DataReady = false;
+      }
+      else if ((Command & 0xFE) == 0x02) Sim->Converting = false;      // POWERDOWN
+      i++;
+    }
+  }
+
+  if (RxData) memcpy(RxData, Response, Length);
+
+  uint64_t Time = (uint64_t)Length * 8ULL * 1000000000ULL / Clock->SPIClock_Hz;
+  Clock->Now_NS += Time;
+  Clock->SPI_NS += Time;
+  Clock->SPIBytes += Length;
+}
+
+/**
+ * @brief  ADC_CS_Write callback of the simulator (Context: Pointer Of Simulated ADS1220)
+ */
+void
+ADS1220_Sim_CS(void *Context, uint8_t Level)
+{
+  ADS1220_Sim_t *Sim = (ADS1220_Sim_t *)Context;
+  if (Sim->CS != Level) Sim->Clock->CSToggles++;
+  Sim->CS = Level;
+}
+
+/**
+ * @brief  ADC_DRDY_Get callback of the simulator (Context: Pointer Of Simulated ADS1220)
+ * @note   Each call that returns HIGH advances the Clock by ADS1220_SIM_POLL_STEP_NS.
+ */
+uint8_t
+ADS1220_Sim_DRDY(void *Context)
+{
+  ADS1220_Sim_t *Sim = (ADS1220_Sim_t *)Context;
+  ADS1220_Sim_Update(Sim);
+  if (Sim->DataReady) return 0;
+  Sim->Clock->Now_NS += ADS1220_SIM_POLL_STEP_NS;
+  Sim->Clock->DRDYWait_NS += ADS1220_SIM_POLL_STEP_NS;
+  return 1;
+}
+
+/**
+ * @brief  ADC_MISO_Get callback of the simulator (Context: Pointer Of Simulated ADS1220)
+ * @note   DOUT/DRDY is LOW only while CS is LOW, DRDYM = 1 and data is ready.
+ *         Each call that returns HIGH advances the Clock by ADS1220_SIM_POLL_STEP_NS.
+ */
+uint8_t
+ADS1220_Sim_MISO(void *Context)
+{
+  ADS1220_Sim_t *Sim = (ADS1220_Sim_t *)Context;
+  ADS1220_Sim_Update(Sim);
+  if (!Sim->CS && (Sim->Reg[3] & 0x02) && Sim->DataReady) return 0;
+  Sim->Clock->Now_NS += ADS1220_SIM_POLL_STEP_NS;
+  Sim->Clock->DRDYWait_NS += ADS1220_SIM_POLL_STEP_NS;
+  return 1;
+}
+
+/**
+ * @brief  ADC_Delay_US callback of the simulator (Advances the active Clock)
+ */
+void
+ADS1220_Sim_Delay_US(uint32_t Delay_US)
+{
+  if (!ADS1220_SimActiveClock) return;
+  ADS1220_SimActiveClock->Now_NS += (uint64_t)Delay_US * 1000ULL;
+  ADS1220_SimActiveClock->Delay_NS += (uint64_t)Delay_US * 1000ULL;
+  ADS1220_SimActiveClock->DelayCalls++;
+}
+
+/**
+ * @brief  ADC_GetTime_US callback of the simulator (Context: Pointer Of Simulated ADS1220)
+ */
+uint32_t
+ADS1220_Sim_GetTime_US(void *Context)
+{
+  return (uint32_t)(((ADS1220_Sim_t *)Context)->Clock->Now_NS / 1000ULL);
+}
+
+/**
+ ** ==================================================================================
+ **                              ##### Benchmark #####
+ ** ==================================================================================
+ **/
+
+typedef struct
+ADS1220_SimBench_s {
+  ADS1220_SimClock_t Clock;
+  ADS1220_Sim_t      Sim;
+  ADS1220_Handler_t  Handler;
+  ADS1220_Parameters_t Parameters;
+  ADS1220_Sequence_t Sequence;
+  ADS1220_Stream_t   Stream;
+  int32_t            Samples[ADS1220_SEQUENCE_MAX];
+} ADS1220_SimBench_t;
+
+typedef struct
+ADS1220_SimBenchCase_s {
+  const char *Name;
+  bool        Continuous;  // Init in Continuous conversion mode
+  bool        DOUT;        // DRDYMode = 1 and no DRDY pin (ADC_MISO_Get)
+  bool        Fresh;       // Measure from power up (Init included)
+  void (*Run)(ADS1220_SimBench_t *Bench);
+} ADS1220_SimBenchCase_t;
+
+typedef struct
+ADS1220_SimThroughputCase_s {
+  const char *Path;
+  bool        Continuous;  // Init in Continuous conversion mode
+  bool        DOUT;        // DRDYMode = 1 and no DRDY pin (ADC_MISO_Get)
+  uint8_t     Channels;    // Samples per channel per Run = 1
+  void (*Run)(ADS1220_SimBench_t *Bench);
+} ADS1220_SimThroughputCase_t;
+
+static const ADS1220_SequenceEntry_t ADS1220_SimBenchEntries[3] = {
+  {P0N1,    _128_, false, false, Internal,     false, Off,     Disabled,  Disabled},
+  {P2N3,    _16_,  false, false, Internal,     true,  _250uA_, AIN0REFP1, Disabled},
+  {P3NAVSS, _1_,   true,  true,  AnalogSupply, false, Off,     Disabled,  Disabled}
+};
+
+static void ADS1220_SimBench_Init(ADS1220_SimBench_t *B)       { ADS1220_Init(&B->Handler, &B->Parameters); }
+static void ADS1220_SimBench_InitFast(ADS1220_SimBench_t *B)   { ADS1220_InitFast(&B->Handler, &B->Parameters); }
+static void ADS1220_SimBench_InitFastCold(ADS1220_SimBench_t *B)
+{
+  ADS1220_Parameters_t Parameters = B->Parameters;
+  Parameters.GainConfig = _8_;
+  ADS1220_InitFast(&B->Handler, &Parameters);
+}
+static void ADS1220_SimBench_StartSync(ADS1220_SimBench_t *B)  { ADS1220_StartSync(&B->Handler); }
+static void ADS1220_SimBench_Reset(ADS1220_SimBench_t *B)      { ADS1220_Reset(&B->Handler); }
+static void ADS1220_SimBench_PowerDown(ADS1220_SimBench_t *B)  { ADS1220_PowerDown(&B->Handler); }
+static void ADS1220_SimBench_ReadData(ADS1220_SimBench_t *B)   { ADS1220_ReadData(&B->Handler, B->Samples); }
+static void ADS1220_SimBench_WaitRead(ADS1220_SimBench_t *B)
+{
+  while (!ADS1220_IsDataReady(&B->Handler));
+  ADS1220_ReadData(&B->Handler, B->Samples);
+}
+static void ADS1220_SimBench_StartWaitRead(ADS1220_SimBench_t *B)
+{
+  ADS1220_StartSync(&B->Handler);
+  ADS1220_SimBench_WaitRead(B);
+}
+static void ADS1220_SimBench_ReadDataDOUT(ADS1220_SimBench_t *B)  { ADS1220_ReadDataDOUT(&B->Handler, B->Samples); }
+static void ADS1220_SimBench_StartReadDOUT(ADS1220_SimBench_t *B)
+{
+  ADS1220_StartSync(&B->Handler);
+  ADS1220_ReadDataDOUT(&B->Handler, B->Samples);
+}
+static void ADS1220_SimBench_ChangeConfig(ADS1220_SimBench_t *B)
+{
+  ADS1220_Parameters_t Parameters = {0};
+  Parameters.InputMuxConfig = P2N3;
+  Parameters.GainConfig = _8_;
+  ADS1220_ChangeConfig(&B->Handler, &Parameters);
+}
+static void ADS1220_SimBench_ChangeGain(ADS1220_SimBench_t *B)        { ADS1220_ChangeGain(&B->Handler, _16_); }
+static void ADS1220_SimBench_SingleShotMode(ADS1220_SimBench_t *B)    { ADS1220_ActivateSingleShotMode(&B->Handler); }
+static void ADS1220_SimBench_ContinuousMode(ADS1220_SimBench_t *B)    { ADS1220_ActivateContinuousMode(&B->Handler); }
+static void ADS1220_SimBench_SingleShotDiff(ADS1220_SimBench_t *B)    { ADS1220_ReadAllSingleShotDiff(&B->Handler, B->Samples, NULL); }
+static void ADS1220_SimBench_ContinuousDiff(ADS1220_SimBench_t *B)    { ADS1220_ReadAllContinuousDiff(&B->Handler, B->Samples, NULL); }
+static void ADS1220_SimBench_SingleShotAVSS(ADS1220_SimBench_t *B)    { ADS1220_ReadAllSingleShotAVSS(&B->Handler, B->Samples, NULL); }
+static void ADS1220_SimBench_ContinuousAVSS(ADS1220_SimBench_t *B)    { ADS1220_ReadAllContinuousAVSS(&B->Handler, B->Samples, NULL); }
+static void ADS1220_SimBench_SyncShadow(ADS1220_SimBench_t *B)        { ADS1220_SyncShadow(&B->Handler); }
+static void ADS1220_SimBench_VerifyShadow(ADS1220_SimBench_t *B)      { ADS1220_VerifyShadow(&B->Handler); }
+static void ADS1220_SimBench_ReadRegs(ADS1220_SimBench_t *B)          { uint8_t Reg01h; ADS1220_ReadRegs(&B->Handler, 1, 1, &Reg01h); }
+static void ADS1220_SimBench_ScrubCheck(ADS1220_SimBench_t *B)
+{
+  ADS1220_Scrub_t Scrub;
+  ADS1220_ScrubInit(&Scrub, 0, 0);
+  ADS1220_ScrubCheck(&B->Handler, &Scrub);
+}
+static void ADS1220_SimBench_ProfileSelect(ADS1220_SimBench_t *B)
+{
+  ADS1220_ProfileBank_t Bank;
+  ADS1220_Parameters_t Parameters = B->Parameters;
+  Parameters.InputMuxConfig = P2N3;
+  Parameters.GainConfig = _128_;
+  Parameters.IDACcurrent = _250uA_;
+  Parameters.IDAC1routing = AIN0REFP1;
+  ADS1220_ProfileBankInit(&Bank);
+  ADS1220_ProfileAdd(&Bank, "RTD", &Parameters);
+  ADS1220_ReadDataProfileSelect(&B->Handler, &Bank, ADS1220_ProfileFind(&Bank, "RTD"), B->Samples);
+}
+static void ADS1220_SimBench_ReadSequence(ADS1220_SimBench_t *B)      { ADS1220_ReadSequence(&B->Handler, &B->Sequence, B->Samples); }
+static void ADS1220_SimBench_StreamRun(ADS1220_SimBench_t *B)         { ADS1220_StreamRun(&B->Handler, &B->Stream, B->Samples); }
+static void ADS1220_SimBench_Scan(ADS1220_SimBench_t *B)
+{
+  ADS1220_Scan_t Scan;
+  ADS1220_ScanStart(&B->Handler, &Scan, ScanAVSS, B->Samples, NULL, NULL);
+  while (Scan.Busy)
+    if (ADS1220_IsDataReady(&B->Handler)) ADS1220_OnDRDY(&B->Handler);
+}
+
+static const ADS1220_SimBenchCase_t ADS1220_SimBenchCases[] = {
+  {"ADS1220_Init",                          false, false, true,  ADS1220_SimBench_Init},
+  {"ADS1220_InitFast (Cold)",               false, false, true,  ADS1220_SimBench_InitFastCold},
+  {"ADS1220_InitFast (Warm, Continuous)",   true,  false, false, ADS1220_SimBench_InitFast},
+  {"ADS1220_StartSync",                     false, false, false, ADS1220_SimBench_StartSync},
+  {"ADS1220_Reset",                         false, false, false, ADS1220_SimBench_Reset},
+  {"ADS1220_PowerDown",                     false, false, false, ADS1220_SimBench_PowerDown},
+  {"ADS1220_ReadData",                      true,  false, false, ADS1220_SimBench_ReadData},
+  {"ADS1220_ReadDataDOUT (Continuous)",     true,  true,  false, ADS1220_SimBench_ReadDataDOUT},
+  {"ADS1220_ChangeConfig",                  false, false, false, ADS1220_SimBench_ChangeConfig},
+  {"ADS1220_ChangeGain",                    false, false, false, ADS1220_SimBench_ChangeGain},
+  {"ADS1220_ActivateSingleShotMode",        true,  false, false, ADS1220_SimBench_SingleShotMode},
+  {"ADS1220_ActivateContinuousMode",        false, false, false, ADS1220_SimBench_ContinuousMode},
+  {"ADS1220_ReadAllSingleShotDiff",         false, false, false, ADS1220_SimBench_SingleShotDiff},
+  {"ADS1220_ReadAllContinuousDiff",         true,  false, false, ADS1220_SimBench_ContinuousDiff},
+  {"ADS1220_ReadAllSingleShotAVSS",         false, false, false, ADS1220_SimBench_SingleShotAVSS},
+  {"ADS1220_ReadAllContinuousAVSS",         true,  false, false, ADS1220_SimBench_ContinuousAVSS},
+  {"ADS1220_SyncShadow",                    false, false, false, ADS1220_SimBench_SyncShadow},
+  {"ADS1220_VerifyShadow",                  false, false, false, ADS1220_SimBench_VerifyShadow},
+  {"ADS1220_ReadRegs (REG01h)",             false, false, false, ADS1220_SimBench_ReadRegs},
+  {"ADS1220_ScrubCheck",                    false, false, false, ADS1220_SimBench_ScrubCheck},
+  {"ADS1220_ReadDataProfileSelect",         true,  false, false, ADS1220_SimBench_ProfileSelect},
+  {"ADS1220_ReadSequence (Single-shot)",    false, false, false, ADS1220_SimBench_ReadSequence},
+  {"ADS1220_ReadSequence (Continuous)",     true,  false, false, ADS1220_SimBench_ReadSequence},
+  {"ADS1220_StreamRun (Continuous)",        true,  false, false, ADS1220_SimBench_StreamRun},
+  {"ADS1220_ScanStart + OnDRDY (AVSS)",     true,  false, false, ADS1220_SimBench_Scan},
+};
+
+static const ADS1220_SimThroughputCase_t ADS1220_SimThroughputCases[] = {
+  {"ReadData (Continuous)",     true,  false, 1, ADS1220_SimBench_WaitRead},
+  {"ReadData (Single-shot)",    false, false, 1, ADS1220_SimBench_StartWaitRead},
+  {"ReadDataDOUT (Continuous)", true,  true,  1, ADS1220_SimBench_ReadDataDOUT},
+  {"ReadDataDOUT (Single-shot)",false, true,  1, ADS1220_SimBench_StartReadDOUT},
+  {"ReadAllSingleShotDiff",     false, false, 2, ADS1220_SimBench_SingleShotDiff},
+  {"ReadAllSingleShotDiff (DOUT)", false, true, 2, ADS1220_SimBench_SingleShotDiff},
+  {"ReadAllContinuousDiff",     true,  false, 2, ADS1220_SimBench_ContinuousDiff},
+  {"ReadAllSingleShotAVSS",     false, false, 4, ADS1220_SimBench_SingleShotAVSS},
+  {"ReadAllContinuousAVSS",     true,  false, 4, ADS1220_SimBench_ContinuousAVSS},
+  {"ReadSequence (Single-shot)",false, false, 3, ADS1220_SimBench_ReadSequence},
+  {"ReadSequence (Continuous)", true,  false, 3, ADS1220_SimBench_ReadSequence},
+  {"StreamRun (Continuous)",    true,  false, 3, ADS1220_SimBench_StreamRun},
+  {"ScanStart + OnDRDY (AVSS)", true,  false, 4, ADS1220_SimBench_Scan},
+};
+
+#define ADS1220_SIM_THROUGHPUT_CASES    (sizeof(ADS1220_SimThroughputCases) / sizeof(ADS1220_SimThroughputCases[0]))
+#define ADS1220_SIM_THROUGHPUT_RESULTS  (ADS1220_SIM_THROUGHPUT_CASES * 3 * 7) // Cases x Operating modes x Data rates
+
+static void
+ADS1220_SimBench_Setup (ADS1220_SimBench_t *Bench, uint8_t Reg01h, bool DOUT, bool Fresh)
+{
+  memset(Bench, 0, sizeof(*Bench));
+  ADS1220_Sim_ClockInit(&Bench->Clock, ADS1220_SPI_CLOCK_HZ);
+  ADS1220_Sim_Init(&Bench->Sim, &Bench->Clock);
+  for (uint8_t Mux = 0; Mux <= P3NAVSS; Mux++)
+    ADS1220_Sim_SetInput(&Bench->Sim, (ADS1220_InputMuxConfig_t)Mux, 0.001f * (Mux + 1), 0.0005f, 50.0f);
+  ADS1220_Sim_Attach(&Bench->Handler, &Bench->Sim);
+  Bench->Parameters.DataRate = (ADS1220_DataRate_t)(Reg01h >> 5);
+  Bench->Parameters.OperatingMode = (ADS1220_OperatingMode_t)((Reg01h >> 3) & 0x03);
+  Bench->Parameters.ConversionMode = (Reg01h >> 2) & 0x01;
+  if (DOUT)
+  {
+    Bench->Parameters.DRDYMode = 1;
+    Bench->Handler.ADC_DRDY_Get = NULL;
+    Bench->Handler.ADC_MISO_Get = ADS1220_Sim_MISO;
+  }
+  if (Fresh) return;
+
+  ADS1220_SimBench_Init(Bench);
+  ADS1220_SequenceInit(&Bench->Handler, &Bench->Sequence, ADS1220_SimBenchEntries, 3);
+  ADS1220_StreamCompile(&Bench->Handler, &Bench->Stream, &Bench->Sequence);
+  ADS1220_StartSync(&Bench->Handler);
+  while (!ADS1220_IsDataReady(&Bench->Handler)); // Device is awake and has data
+}
+
+static void
+ADS1220_SimBench_Record (ADS1220_SimBenchResult_t *Result, const char *Name, const ADS1220_SimClock_t *Clock, uint64_t Start_NS)
+{
+  Result->Name = Name;
+  Result->SPIBytes = Clock->SPIBytes;
+  Result->CSToggles = Clock->CSToggles;
+  Result->Delay_US = (uint32_t)(Clock->Delay_NS / 1000ULL);
+  Result->DRDYWait_US = (uint32_t)(Clock->DRDYWait_NS / 1000ULL);
+  Result->SPI_US = (uint32_t)(Clock->SPI_NS / 1000ULL);
+  Result->Wall_US = (uint32_t)((Clock->Now_NS - Start_NS) / 1000ULL);
+}
+
+/**
+ * @brief  Runs every public function of the library on a fresh simulated ADS1220 and records its cost
+ * @param  Results:     Pointer Of Results Array
+ * @param  MaxResults:  Number of Elements of Results
+ * @retval Number of results
+ */
+uint8_t
+ADS1220_Sim_Benchmark(ADS1220_SimBenchResult_t *Results, uint8_t MaxResults)
+{
+  static ADS1220_SimBench_t Bench;
+  uint8_t Count = 0;
+
+  for (size_t i = 0; i < sizeof(ADS1220_SimBenchCases) / sizeof(ADS1220_SimBenchCases[0]) && Count < MaxResults; i++)
+  {
+    const ADS1220_SimBenchCase_t *Case = &ADS1220_SimBenchCases[i];
+    ADS1220_SimBench_Setup(&Bench, Case->Continuous ? 0x04 : 0x00, Case->DOUT, Case->Fresh);
+    ADS1220_Sim_ClockResetStats(&Bench.Clock);
+    uint64_t Start = Bench.Clock.Now_NS;
+    Case->Run(&Bench);
+    ADS1220_SimBench_Record(&Results[Count++], Case->Name, &Bench.Clock, Start);
+  }
+  return Count;
+}
+
+/**
+ * @brief  Measures the aggregate sample rate of N simulated ADS1220s on one bus (ADS1220_BusReadAll)
+ * @param  Count:       Number of Devices (1 - 32)
+ * @param  Reg01h:      REG01h of all devices (Data rate, Operating and Conversion mode)
+ * @param  Duration_MS: Simulated duration in MilliSecond
+ * @retval Aggregate samples per second
+ */
+float
+ADS1220_Sim_BusBenchmark(uint8_t Count, uint8_t Reg01h, uint32_t Duration_MS)
+{
+  static ADS1220_Sim_t Sims[32];
+  static ADS1220_Handler_t Handlers[32];
+  static ADS1220_Handler_t *Devices[32];
+  static int32_t Samples[32];
+  ADS1220_SimClock_t Clock;
+  ADS1220_Bus_t Bus;
+
+  if (!Count || Count > 32) return 0.0f;
+  ADS1220_Sim_ClockInit(&Clock, ADS1220_SPI_CLOCK_HZ);
+  for (uint8_t i = 0; i < Count; i++)
+  {
+    ADS1220_Parameters_t Parameters = {0};
+    Parameters.DataRate = (ADS1220_DataRate_t)(Reg01h >> 5);
+    Parameters.OperatingMode = (ADS1220_OperatingMode_t)((Reg01h >> 3) & 0x03);
+    Parameters.ConversionMode = (Reg01h >> 2) & 0x01;
+    memset(&Handlers[i], 0, sizeof(Handlers[i]));
+    ADS1220_Sim_Init(&Sims[i], &Clock);
+    ADS1220_Sim_Attach(&Handlers[i], &Sims[i]);
+    ADS1220_Init(&Handlers[i], &Parameters);
+    Devices[i] = &Handlers[i];
+  }
+  ADS1220_BusInit(&Bus, Devices, Count, Samples);
+
+  uint64_t Start = Clock.Now_NS, End = Start + (uint64_t)Duration_MS * 1000000ULL;
+  while (Clock.Now_NS < End)
+    ADS1220_BusReadAll(&Bus);
+  return (float)Bus.SampleCounter * 1e9f / (float)(Clock.Now_NS - Start);
+}
+
+/**
+ * @brief  Prints benchmark results as a table (stdout)
+ * @param  Results:     Pointer Of Results Array
+ * @param  Count:       Number of results
+ * @retval None
+ */
+void
+ADS1220_Sim_PrintBenchmark(const ADS1220_SimBenchResult_t *Results, uint8_t Count)
+{
+  printf("%-38s %9s %9s %10s %12s %9s %11s\r\n", "Function", "SPI Bytes", "CS Edges", "Delay(us)", "DRDY Wait(us)", "SPI(us)", "Wall(us)");
+  for (uint8_t i = 0; i < Count; i++)
+    printf("%-38s %9lu %9lu %10lu %12lu %9lu %11lu\r\n", Results[i].Name,
+           (unsigned long)Results[i].SPIBytes, (unsigned long)Results[i].CSToggles, (unsigned long)Results[i].Delay_US,
+           (unsigned long)Results[i].DRDYWait_US, (unsigned long)Results[i].SPI_US, (unsigned long)Results[i].Wall_US);
+}
+
+/**
+ * @brief  Measures effective throughput of every acquisition path at every Data rate and Operating mode
+ * @note   Each entry runs one warm-up pass, then Passes measured passes, on a fresh simulated ADS1220.
+ *         Theoretical_SPS is the nominal data rate shared by the channels of the path.
+ * @param  Results:     Pointer Of Results Array
+ * @param  MaxResults:  Number of Elements of Results
+ * @param  Passes:      Number of measured passes of each path (Samples per channel)
+ * @retval Number of results of the whole matrix | If it is more than MaxResults, only the first MaxResults are measured
+ */
+uint16_t
+ADS1220_Sim_Throughput(ADS1220_SimThroughput_t *Results, uint16_t MaxResults, uint8_t Passes)
+{
+  static ADS1220_SimBench_t Bench;
+  uint16_t Count = 0;
+
+  if (!Passes) return 0;
+  for (size_t i = 0; i < ADS1220_SIM_THROUGHPUT_CASES; i++)
+  {
+    const ADS1220_SimThroughputCase_t *Case = &ADS1220_SimThroughputCases[i];
+    for (uint8_t Mode = NormalMode; Mode <= TurboMode; Mode++)
+    {
+      for (uint8_t Rate = 0; Rate <= 6; Rate++)
+      {
+        if (Count >= MaxResults) { Count++; continue; } // Truncated: Counted, not measured
+        ADS1220_SimThroughput_t *Result = &Results[Count++];
+        uint8_t Reg01h = (uint8_t)((Rate << 5) | (Mode << 3) | (Case->Continuous ? 0x04 : 0x00));
+
+        ADS1220_SimBench_Setup(&Bench, Reg01h, Case->DOUT, false);
+        Case->Run(&Bench); // Warm-up pass
+        ADS1220_Sim_ClockResetStats(&Bench.Clock);
+        uint64_t Start = Bench.Clock.Now_NS;
+        for (uint8_t Pass = 0; Pass < Passes; Pass++)
+          Case->Run(&Bench);
+        float Wall_S = (float)(Bench.Clock.Now_NS - Start) * 1e-9f;
+
+        Result->Path = Case->Path;
+        Result->DataRate = (ADS1220_DataRate_t)Rate;
+        Result->OperatingMode = (ADS1220_OperatingMode_t)Mode;
+        Result->Channels = Case->Channels;
+        Result->Nominal_SPS = ADS1220_Sim_DataRate(Reg01h);
+        Result->Theoretical_SPS = Result->Nominal_SPS / (float)Case->Channels;
+        Result->Achieved_SPS = (float)Passes / Wall_S;
+        Result->Gap_Percent = 100.0f * (1.0f - Result->Achieved_SPS / Result->Theoretical_SPS);
+        Result->Delay_US = (uint32_t)(Bench.Clock.Delay_NS / 1000ULL);
+        Result->DRDYWait_US = (uint32_t)(Bench.Clock.DRDYWait_NS / 1000ULL);
+        Result->SPI_US = (uint32_t)(Bench.Clock.SPI_NS / 1000ULL);
+        Result->Wall_US = (uint32_t)((Bench.Clock.Now_NS - Start) / 1000ULL);
+      }
+    }
+  }
+  return Count;
+}
+
+/**
+ * @brief  Prints throughput results as CSV or JSON (stdout)
+ * @param  Results:     Pointer Of Results Array
+ * @param  Count:       Number of results
+ * @param  Format:      See ADS1220_SimFormat enum
+ * @retval None
+ */
+void
+ADS1220_Sim_PrintThroughput(const ADS1220_SimThroughput_t *Results, uint16_t Count, ADS1220_SimFormat_t Format)
+{
+  static const char *const Modes[3] = {"Normal", "DutyCycle", "Turbo"};
+
+  if (Format == SimCSV)
+    printf("path,mode,data_rate,nominal_sps,channels,theoretical_sps,achieved_sps,gap_percent,delay_us,drdy_wait_us,spi_us,wall_us\n");
+  else
+    printf("[\n");
+
+  for (uint16_t i = 0; i < Count; i++)
+  {
+    const ADS1220_SimThroughput_t *R = &Results[i];
+    if (Format == SimCSV)
+      printf("\"%s\",%s,%u,%.2f,%u,%.3f,%.3f,%.2f,%lu,%lu,%lu,%lu\n",
+             R->Path, Modes[R->OperatingMode], (unsigned)R->DataRate, R->Nominal_SPS, R->Channels, R->Theoretical_SPS,
+             R->Achieved_SPS, R->Gap_Percent, (unsigned long)R->Delay_US, (unsigned long)R->DRDYWait_US,
+             (unsigned long)R->SPI_US, (unsigned long)R->Wall_US);
+    else
+      printf("  {\"path\": \"%s\", \"mode\": \"%s\", \"data_rate\": %u, \"nominal_sps\": %.2f, \"channels\": %u, "
+             "\"theoretical_sps\": %.3f, \"achieved_sps\": %.3f, \"gap_percent\": %.2f, \"delay_us\": %lu, "
+             "\"drdy_wait_us\": %lu, \"spi_us\": %lu, \"wall_us\": %lu}%s\n",
+             R->Path, Modes[R->OperatingMode], (unsigned)R->DataRate, R->Nominal_SPS, R->Channels, R->Theoretical_SPS,
+             R->Achieved_SPS, R->Gap_Percent, (unsigned long)R->Delay_US, (unsigned long)R->DRDYWait_US,
+             (unsigned long)R->SPI_US, (unsigned long)R->Wall_US, (i + 1 < Count) ? "," : "");
+  }
+
+  if (Format == SimJSON) printf("]\n");
+}
+
+#ifdef ADS1220_SIM_MAIN
+// Largest difference between ADCValueToFixed and the float macros evaluated in double, over every ADC value, in output units
+// Same float arguments as the init functions, so only the fixed-point rounding is measured
+#define ADS1220_SIM_FIXED_ERROR(Error, Init, Reference) do {                               \
+    ADS1220_FixedScale_t Scale; Error = -1.0;                                              \
+    if (!(Init)) break;                                                                    \
+    Error = 0.0;                                                                           \
+    for (int32_t x = -0x800000; x <= 0x7FFFFF; x++) {                                      \
+      double Diff = fabs((double)ADCValueToFixed(x, &Scale) - (Reference));                \
+      if (Diff > Error) Error = Diff;                                                      \
+    }                                                                                      \
+  } while (0)
+
+#define ADS1220_SIM_FIXED_CASES     12
+#define ADS1220_SIM_FIXED_LSB       0.505 // Round to nearest (0.5) plus Multiplier quantization (< UnitsPerCode / 256, all cases below have UnitsPerCode < 1)
+
+static const char *ADS1220_SimFixedName[ADS1220_SIM_FIXED_CASES] =
+{
+  "Voltage/1", "Voltage/2", "Voltage/4", "Voltage/8", "Voltage/16", "Voltage/32", "Voltage/64", "Voltage/128",
+  "Current", "Weight", "FullScale", "RTD"
+};
+
+static void
+ADS1220_Sim_FixedAccuracy (double *Error)
+{
+  for (uint8_t g = _1_; g <= _128_; g++)
+    ADS1220_SIM_FIXED_ERROR(Error[g], ADS1220_FixedInitVoltage(&Scale, 2.048f, (ADS1220_GainConfig_t)g, 1e-6f),
+                            ADCValueToVoltage(x, (double)2.048f, (double)(1 << g)) / (double)1e-6f);
+  ADS1220_SIM_FIXED_ERROR(Error[8], ADS1220_FixedInitCurrent(&Scale, 10.0f, 2.048f, _1_, 1e-7f),
+                          ADCValueToCurrent(x, 10.0, (double)2.048f, 1.0) / (double)1e-7f);
+  ADS1220_SIM_FIXED_ERROR(Error[9], ADS1220_FixedInitWeight(&Scale, 50.0f, 2.0f, _128_, 1e-3f),
+                          ADCValueToWeight(x, 50.0, 2.0, 128.0) / (double)1e-3f);
+  ADS1220_SIM_FIXED_ERROR(Error[10], ADS1220_FixedInitFullScale(&Scale, 400.0f, 1e-4f),
+                          ADCValueToDisplacement(x, 400.0) / (double)1e-4f);
+  ADS1220_SIM_FIXED_ERROR(Error[11], ADS1220_FixedInitRTD(&Scale, 1620.0f, 100.0f, 0.00385f, _16_, 1e-3f),
+                          ((double)x / 0x7FFFFF * 2.0 * 1620.0 / 16.0 / 100.0 - 1.0) / (double)0.00385f / (double)1e-3f); // ADCValueToTemperatureRTD divides x in float
+}
+
+// Self tests (./ads1220_bench test): every failed check is printed, the exit code is the number of failures
+static uint16_t ADS1220_SimTestChecks, ADS1220_SimTestFailures;
+#define ADS1220_SIM_CHECK(Cond, ...) do {                                                   \
+    ADS1220_SimTestChecks++;                                                               \
+    if (!(Cond)) {                                                                         \
+      ADS1220_SimTestFailures++;                                                           \
+      printf("FAIL %s:%d: ", __FILE__, __LINE__); printf(__VA_ARGS__); printf("\r\n");     \
+    }                                                                                      \
+  } while (0)
+
+// Running statistics of Count samples against a two-pass double reference
+static void
+ADS1220_Sim_TestStatsCase (const char *Name, const int32_t *Samples, uint16_t Count)
+{
+  ADS1220_Stats_t Stats;
+  double Mean = 0.0, Variance = 0.0;
+  ADS1220_StatsReset(&Stats);
+  for (uint16_t i = 0; i < Count; i++)
+  {
+    ADS1220_StatsUpdate(&Stats, Samples[i]);
+    Mean += Samples[i];
+  }
+  Mean /= Count;
+  for (uint16_t i = 0; i < Count; i++) Variance += (Samples[i] - Mean) * (Samples[i] - Mean);
+  Variance /= (Count - 1);
+
+  ADS1220_SIM_CHECK(fabs(ADS1220_StatsMean(&Stats) - Mean) < 1e-6, "%s mean %.6f, reference %.6f", Name, ADS1220_StatsMean(&Stats), Mean);
+  ADS1220_SIM_CHECK(fabs(ADS1220_StatsVariance(&Stats) - Variance) <= 1e-9 * (Variance + 1.0),
+                    "%s variance %.6f, reference %.6f", Name, ADS1220_StatsVariance(&Stats), Variance);
+}
+
+static void
+ADS1220_Sim_TestStats (void)
+{
+  static int32_t Samples[4000];
+  uint32_t Seed = 1;
+
+  for (uint16_t i = 0; i < 4000; i++) Samples[i] = (i < 2000) ? 8388000 : 8388003; // Step near full scale
+  ADS1220_Sim_TestStatsCase("Step", Samples, 4000);
+  for (uint16_t i = 0; i < 4000; i++)
+  {
+    Seed = Seed * 1664525u + 1013904223u;
+    Samples[i] = 8388000 + (int32_t)((Seed >> 16) % 3);                                 // 0..2 codes of noise near full scale
+  }
+  ADS1220_Sim_TestStatsCase("Noise", Samples, 4000);
+  for (uint16_t i = 0; i < 4000; i++) Samples[i] = (i & 1) ? 0x7FFFFF : -0x800000;      // Full swing
+  ADS1220_Sim_TestStatsCase("Swing", Samples, 4000);
+}
+
+// Broken DRDY lines (Time still runs while DRDY is polled)
+static uint8_t ADS1220_Sim_DRDYLow(void *Context)  { ((ADS1220_Sim_t *)Context)->Clock->Now_NS += ADS1220_SIM_POLL_STEP_NS; return 0; }
+static uint8_t ADS1220_Sim_DRDYHigh(void *Context) { ((ADS1220_Sim_t *)Context)->Clock->Now_NS += ADS1220_SIM_POLL_STEP_NS; return 1; }
+
+// DRDY that goes LOW ADS1220_SimDRDYLows times, then stays HIGH (Device stops in the middle of a scan)
+static uint8_t ADS1220_SimDRDYLows;
+static uint8_t
+ADS1220_Sim_DRDYStop (void *Context)
+{
+  if (ADS1220_SimDRDYLows && !ADS1220_Sim_DRDY(Context)) { ADS1220_SimDRDYLows--; return 0; }
+  return ADS1220_Sim_DRDYHigh(Context);
+}
+
+// ADS1220_InitFast on a warm restart: New handler, same (simulated) device
+static bool
+ADS1220_Sim_TestWarm (ADS1220_SimBench_t *Bench, ADS1220_Parameters_t *Parameters, uint8_t (*DRDY)(void *Context))
+{
+  memset(&Bench->Handler, 0, sizeof(Bench->Handler));
+  ADS1220_Sim_Attach(&Bench->Handler, &Bench->Sim);
+  if (DRDY) Bench->Handler.ADC_DRDY_Get = DRDY;
+  return ADS1220_InitFast(&Bench->Handler, Parameters);
+}
+
+static void
+ADS1220_Sim_TestInitFast (void)
+{
+  static ADS1220_SimBench_t Bench;
+  ADS1220_Parameters_t Parameters;
+
+  ADS1220_SimBench_Setup(&Bench, 0x00, false, true);
+  ADS1220_SIM_CHECK(!ADS1220_InitFast(&Bench.Handler, &Bench.Parameters), "InitFast trusted all 0x00 registers");
+  Parameters = Bench.Parameters;
+  Parameters.GainConfig = _8_;
+  ADS1220_SimBench_Setup(&Bench, 0x00, false, true);
+  ADS1220_SIM_CHECK(!ADS1220_InitFast(&Bench.Handler, &Parameters), "InitFast cold start reported warm");
+  ADS1220_SIM_CHECK(ADS1220_VerifyShadow(&Bench.Handler), "InitFast cold start did not write the registers");
+  ADS1220_SIM_CHECK(ADS1220_Sim_TestWarm(&Bench, &Parameters, NULL), "InitFast Single-shot warm restart not detected");
+  ADS1220_SIM_CHECK(ADS1220_GetPowerState(&Bench.Handler) == StateIdle, "InitFast Single-shot power state %d", ADS1220_GetPowerState(&Bench.Handler));
+
+  ADS1220_SimBench_Setup(&Bench, 0x04, false, false);
+  ADS1220_SIM_CHECK(ADS1220_Sim_TestWarm(&Bench, &Bench.Parameters, NULL), "InitFast Continuous warm restart not detected");
+  ADS1220_SIM_CHECK(ADS1220_GetPowerState(&Bench.Handler) == StateContinuous, "InitFast Continuous power state %d", ADS1220_GetPowerState(&Bench.Handler));
+  ADS1220_PowerDown(&Bench.Handler);
+  ADS1220_SIM_CHECK(ADS1220_Sim_TestWarm(&Bench, &Bench.Parameters, NULL), "InitFast after POWERDOWN not detected");
+  ADS1220_SIM_CHECK(ADS1220_GetPowerState(&Bench.Handler) == StateContinuous, "InitFast did not restart the conversions");
+  ADS1220_SIM_CHECK(!ADS1220_Sim_TestWarm(&Bench, &Bench.Parameters, ADS1220_Sim_DRDYLow), "InitFast trusted DRDY stuck LOW");
+  ADS1220_SimBench_Setup(&Bench, 0x04, false, false);
+  ADS1220_SIM_CHECK(!ADS1220_Sim_TestWarm(&Bench, &Bench.Parameters, ADS1220_Sim_DRDYHigh), "InitFast trusted DRDY stuck HIGH");
+}
+
+// A stream that times out after its first WREG must leave the device and the shadow registers in the state before it
+static void
+ADS1220_Sim_TestStreamTimeout (void)
+{
+  static ADS1220_SimBench_t Bench;
+  uint8_t Before[4];
+  ADS1220_SimBench_Setup(&Bench, 0x04, false, false);
+  memcpy(Before, Bench.Sim.Reg, 4);
+  Bench.Handler.ADC_DRDY_Get = ADS1220_Sim_DRDYHigh;
+  ADS1220_SIM_CHECK(ADS1220_StreamRun(&Bench.Handler, &Bench.Stream, Bench.Samples) == ResultTimeout, "StreamRun did not time out");
+  ADS1220_SIM_CHECK(!memcmp(Before, Bench.Sim.Reg, 4), "StreamRun timeout did not restore the registers");
+  ADS1220_SIM_CHECK(ADS1220_VerifyShadow(&Bench.Handler), "StreamRun timeout left the shadow registers out of sync");
+}
+
+// Auto-ranged sequence whose DRDY stops after the first channel: distinct status, outputs and gains untouched
+static void
+ADS1220_Sim_TestAutoRangeTimeout (void)
+{
+  static ADS1220_SimBench_t Bench;
+  ADS1220_AutoRange_t AutoRange;
+  uint8_t Gain[ADS1220_SEQUENCE_MAX];
+  uint8_t Changed = 0xFF;
+  ADS1220_SimBench_Setup(&Bench, 0x00, false, false);
+  ADS1220_AutoRangeInit(&AutoRange, &Bench.Sequence, 10, 10);
+  ADS1220_SIM_CHECK(ADS1220_ReadSequenceAutoRange(&Bench.Handler, &Bench.Sequence, &AutoRange, Bench.Samples, &Changed) == ResultOK,
+                    "ReadSequenceAutoRange failed");
+  memcpy(Gain, AutoRange.Gain, sizeof(Gain));
+  for (uint8_t i = 0; i < Bench.Sequence.Count; i++) Bench.Samples[i] = 0x5A5A5A5A;
+  Bench.Handler.ADC_DRDY_Get = ADS1220_Sim_DRDYStop;
+  ADS1220_SimDRDYLows = 1;
+  Changed = 0xFF;
+  ADS1220_SIM_CHECK(ADS1220_ReadSequenceAutoRange(&Bench.Handler, &Bench.Sequence, &AutoRange, Bench.Samples, &Changed) == ResultTimeout,
+                    "ReadSequenceAutoRange did not time out");
+  ADS1220_SIM_CHECK(Changed == 0, "ReadSequenceAutoRange timeout reported gain changes 0x%02X", (unsigned)Changed);
+  ADS1220_SIM_CHECK(!memcmp(Gain, AutoRange.Gain, sizeof(Gain)), "ReadSequenceAutoRange timeout changed the gains");
+  for (uint8_t i = 0; i < Bench.Sequence.Count; i++)
+    ADS1220_SIM_CHECK(Bench.Samples[i] == 0x5A5A5A5A, "ReadSequenceAutoRange timeout wrote channel %u", i);
+}
+
+// Bus of devices without DRDY pin (DOUT/DRDY only), then one device that never has data
+static void
+ADS1220_Sim_TestBusDOUT (void)
+{
+  static ADS1220_Sim_t Sims[3];
+  static ADS1220_Handler_t Handlers[3];
+  ADS1220_Handler_t *Devices[3];
+  int32_t Samples[3];
+  ADS1220_SimClock_t Clock;
+  ADS1220_Parameters_t Parameters = {0};
+  ADS1220_Bus_t Bus;
+
+  Parameters.DataRate = _1000_SPS_;
+  Parameters.DRDYMode = 1;
+  ADS1220_Sim_ClockInit(&Clock, ADS1220_SPI_CLOCK_HZ);
+  for (uint8_t i = 0; i < 3; i++)
+  {
+    memset(&Handlers[i], 0, sizeof(Handlers[i]));
+    ADS1220_Sim_Init(&Sims[i], &Clock);
+    ADS1220_Sim_Attach(&Handlers[i], &Sims[i]);
+    Handlers[i].ADC_DRDY_Get = NULL;
+    Handlers[i].ADC_MISO_Get = ADS1220_Sim_MISO;
+    ADS1220_Init(&Handlers[i], &Parameters);
+    Devices[i] = &Handlers[i];
+  }
+  ADS1220_BusInit(&Bus, Devices, 3, Samples);
+  ADS1220_SIM_CHECK(ADS1220_BusReadAll(&Bus) == ResultOK && Bus.ReadyMask == 0x07, "BusReadAll (DOUT/DRDY) mask 0x%02X", (unsigned)Bus.ReadyMask);
+  Handlers[1].ADC_MISO_Get = ADS1220_Sim_DRDYHigh;
+  ADS1220_SIM_CHECK(ADS1220_BusReadAll(&Bus) == ResultTimeout && Bus.ReadyMask == 0x05, "BusReadAll did not time out on a silent device");
+  ADS1220_BusInit(&Bus, NULL, 0, NULL);
+  ADS1220_SIM_CHECK(ADS1220_BusReadAll(&Bus) == ResultOK && !Bus.ReadyMask, "BusReadAll failed on an empty bus");
+}
+
+// Delay budget of each public function: Every ADC_Delay_US call is summed, SPI is a no-op
+static uint32_t ADS1220_SimTestDelay_US;
+static void    ADS1220_Sim_TestDelay(uint32_t Delay_US)                  { ADS1220_SimTestDelay_US += Delay_US; }
+static void    ADS1220_Sim_TestCS(void *Context, uint8_t Level)          { (void)Context; (void)Level; }
+static void    ADS1220_Sim_TestTransmit(uint8_t Data)                    { (void)Data; }
+static uint8_t ADS1220_Sim_TestReceive(void)                             { return 0; }
+static void    ADS1220_Sim_TestTransfer(void *Context, const uint8_t *TxData, uint8_t *RxData, uint16_t Length)
+{
+  (void)Context; (void)TxData;
+  if (RxData) memset(RxData, 0, Length);
+}
+
+#define ADS1220_SIM_DELAY(Handler, Call, Expected) do {                                      \
+    ADS1220_SimTestDelay_US = 0;                                                           \
+    Call;                                                                                  \
+    ADS1220_SIM_CHECK(ADS1220_SimTestDelay_US == (Expected), "%s (%s) delay %u us, budget %u us", \
+                      #Call, (Handler)->ADC_Transfer ? "Transfer" : "Per-byte",              \
+                      (unsigned)ADS1220_SimTestDelay_US, (unsigned)(Expected));             \
+  } while (0)
+
+static void
+ADS1220_Sim_TestDelayBudget (void)
+{
+  static const ADS1220_Timing_t Timing = {2, 3, 5, 7, 100}; // CSSetup, CSHold, CSHigh, InterByte, Reset
+  const uint32_t Frame = 2 + 3 + 5;                         // Budget of one frame without inter-byte gaps
+  ADS1220_Handler_t Handler;
+  ADS1220_Parameters_t Parameters = {0};
+  uint8_t RegsValue[4];
+  int32_t Sample;
+  
+#if ADS1220_TIMING_PROFILE == 1
+  {
+    const ADS1220_Timing_t Default = ADS1220_TIMING_DEFAULT;
+    ADS1220_Timing_t Derived;
+    ADS1220_TimingInit(&Derived, ADS1220_SPI_CLOCK_HZ, ADS1220_FCLK_HZ);
+    ADS1220_SIM_CHECK(!memcmp(&Default, &Derived, sizeof(Derived)), "ADS1220_TimingInit does not match ADS1220_TIMING_DEFAULT");
+  }
+#endif
+  Parameters.GainConfig = _8_;
+  for (uint8_t PerByte = 0; PerByte < 2; PerByte++)
+  {
+    uint32_t Gap = PerByte ? Timing.InterByte_US : 0;      // (N - 1) gaps per frame of N bytes
+    memset(&Handler, 0, sizeof(Handler));
+    Handler.ADC_CS_Write = ADS1220_Sim_TestCS;
+    Handler.ADC_Delay_US = ADS1220_Sim_TestDelay;
+    Handler.Timing = &Timing;
+    if (PerByte)
+    {
+      Handler.ADC_Transmit = ADS1220_Sim_TestTransmit;
+      Handler.ADC_Receive = ADS1220_Sim_TestReceive;
+    }
+    else Handler.ADC_Transfer = ADS1220_Sim_TestTransfer;
+    
+    ADS1220_SIM_DELAY(&Handler, ADS1220_Init(&Handler, &Parameters), Timing.Reset_US + (Frame + Timing.Reset_US) + (Frame + 4 * Gap));
+    ADS1220_SIM_DELAY(&Handler, ADS1220_StartSync(&Handler), Frame);
+    ADS1220_SIM_DELAY(&Handler, ADS1220_PowerDown(&Handler), Frame);
+    ADS1220_SIM_DELAY(&Handler, ADS1220_ReadData(&Handler, &Sample), Frame + 2 * Gap);
+    ADS1220_SIM_DELAY(&Handler, ADS1220_ReadRegs(&Handler, 0, 4, RegsValue), Frame + 4 * Gap);
+    ADS1220_SIM_DELAY(&Handler, ADS1220_ChangeGain(&Handler, _16_), Frame + Gap);
+    ADS1220_SIM_DELAY(&Handler, ADS1220_ChangeGain(&Handler, _16_), 0);
+    ADS1220_SIM_DELAY(&Handler, ADS1220_ChangeConfig(&Handler, &Parameters), Frame + Gap);
+    ADS1220_SIM_DELAY(&Handler, ADS1220_ActivateContinuousMode(&Handler), Frame + Gap);
+    ADS1220_SIM_DELAY(&Handler, ADS1220_ActivateSingleShotMode(&Handler), Frame + Gap);
+    ADS1220_SIM_DELAY(&Handler, ADS1220_Reset(&Handler), Frame + Timing.Reset_US);
+  }
+}
+
+// Data bytes of every sample frame must be clocked in with a read (Not overwritten by a pipelined WREG)
+static bool
+ADS1220_Sim_StreamSplit (const ADS1220_Stream_t *Stream)
+{
+  for (uint8_t i = 0; i < Stream->FrameCount; i++)
+    if ((Stream->Frames[i].Flags & ADS1220_STREAM_WAIT_DRDY) && Stream->Frames[i].Length != 3) return false;
+  return true;
+}
+
+static void
+ADS1220_Sim_TestStream (void)
+{
+  static ADS1220_SimBench_t Bench;
+
+  // Continuous conversion mode right after Init: The device was never started
+  ADS1220_SimBench_Setup(&Bench, 0x04, false, true);
+  ADS1220_SimBench_Init(&Bench);
+  ADS1220_SequenceInit(&Bench.Handler, &Bench.Sequence, ADS1220_SimBenchEntries, 3);
+  ADS1220_StreamCompile(&Bench.Handler, &Bench.Stream, &Bench.Sequence);
+  ADS1220_SIM_CHECK(!ADS1220_Sim_StreamSplit(&Bench.Stream), "StreamCompile did not pipeline the WREG with ADC_Transfer");
+  ADS1220_SIM_CHECK(ADS1220_StreamRun(&Bench.Handler, &Bench.Stream, Bench.Samples) == ResultOK,
+                    "StreamRun timed out without a prior START/SYNC");
+  ADS1220_SIM_CHECK(ADS1220_StreamRun(&Bench.Handler, &Bench.Stream, Bench.Samples) == ResultOK, "StreamRun failed while running");
+
+  // Single-shot mode: The read, the WREG and the START/SYNC are separate frames
+  ADS1220_SimBench_Setup(&Bench, 0x00, false, false);
+  ADS1220_SIM_CHECK(ADS1220_Sim_StreamSplit(&Bench.Stream), "StreamCompile merged a read and a WREG in Single-shot mode");
+  ADS1220_SIM_CHECK(ADS1220_StreamRun(&Bench.Handler, &Bench.Stream, Bench.Samples) == ResultOK, "StreamRun failed in Single-shot mode");
+
+  // Continuous conversion mode without a full-duplex callback (Only compiled, the SPI stubs are of the delay budget test)
+  ADS1220_SimBench_Setup(&Bench, 0x04, false, false);
+  Bench.Handler.ADC_Transfer = NULL;
+  Bench.Handler.ADC_Transmit = ADS1220_Sim_TestTransmit;
+  Bench.Handler.ADC_Receive = ADS1220_Sim_TestReceive;
+  ADS1220_StreamCompile(&Bench.Handler, &Bench.Stream, &Bench.Sequence);
+  ADS1220_SIM_CHECK(ADS1220_Sim_StreamSplit(&Bench.Stream), "StreamCompile merged a read and a WREG without ADC_Transfer");
+}
+
+// Oversampled sequence in Continuous conversion mode right after Init: The device was never started
+static void
+ADS1220_Sim_TestOversampled (void)
+{
+  static ADS1220_SimBench_t Bench;
+  ADS1220_Stats_t Stats[3] = {0};
+
+  ADS1220_SimBench_Setup(&Bench, 0x04, false, true);
+  ADS1220_SimBench_Init(&Bench);
+  ADS1220_SequenceInit(&Bench.Handler, &Bench.Sequence, ADS1220_SimBenchEntries, 3);
+  ADS1220_SIM_CHECK(ADS1220_ReadSequenceOversampled(&Bench.Handler, &Bench.Sequence, Stats, 4) == ResultOK,
+                    "ReadSequenceOversampled timed out without a prior START/SYNC");
+  for (uint8_t i = 0; i < 3; i++)
+    ADS1220_SIM_CHECK(Stats[i].Count == 4, "ReadSequenceOversampled channel %u has %u samples", i, (unsigned)Stats[i].Count);
+  ADS1220_SIM_CHECK(ADS1220_ReadSequence(&Bench.Handler, &Bench.Sequence, Bench.Samples) == ResultOK, "ReadSequence failed after oversampling");
+}
+
+// Batch decode with the kernel of this build against the scalar kernel, for every length up to 1001 samples
+// RawData is copied to the end of an exact-size heap buffer, so a build with -fsanitize=address also catches over-reads
+#define ADS1220_SIM_DECODE_MAX      1001
+#define ADS1220_SIM_DECODE_GUARD    0x5A5A5A5A
+
+static void
+ADS1220_Sim_TestDecode (void)
+{
+  static const uint8_t Known[9] = {0x7F, 0xFF, 0xFF, 0x80, 0x00, 0x00, 0xFF, 0xFF, 0xFF};
+  static uint8_t Pattern[3 * ADS1220_SIM_DECODE_MAX];
+  static int32_t Reference[ADS1220_SIM_DECODE_MAX], Output[ADS1220_SIM_DECODE_MAX + 8];
+  int32_t KnownSample[3];
+  int32_t WrongLength = -1, OverrunLength = -1;
+  uint32_t Seed = 1;
+
+  ADS1220_DecodeBatch(Known, KnownSample, 3);
+  ADS1220_SIM_CHECK(KnownSample[0] == 0x7FFFFF && KnownSample[1] == -0x800000 && KnownSample[2] == -1,
+                    "DecodeBatch (%s) known values %ld %ld %ld", ADS1220_DecodeKernel(),
+                    (long)KnownSample[0], (long)KnownSample[1], (long)KnownSample[2]);
+
+  for (uint32_t i = 0; i < sizeof(Pattern); i++)
+  {
+    Seed = Seed * 1103515245u + 12345u;
+    Pattern[i] = (uint8_t)(Seed >> 16);
+  }
+  for (uint32_t Count = 0; Count <= ADS1220_SIM_DECODE_MAX; Count++)
+  {
+    uint8_t *RawData = (uint8_t *)malloc(3 * Count + 1); // + 1: malloc(0) may return NULL
+    if (!RawData) break;
+    memcpy(RawData, Pattern, 3 * Count);
+    for (uint32_t i = 0; i < ADS1220_SIM_DECODE_MAX + 8; i++) Output[i] = ADS1220_SIM_DECODE_GUARD;
+    ADS1220_DecodeBatchScalar(RawData, Reference, Count);
+    ADS1220_DecodeBatch(RawData, Output, Count);
+    free(RawData);
+    if (WrongLength < 0 && memcmp(Reference, Output, Count * sizeof(int32_t))) WrongLength = (int32_t)Count;
+    for (uint32_t i = Count; i < Count + 8; i++)
+      if (OverrunLength < 0 && Output[i] != ADS1220_SIM_DECODE_GUARD) OverrunLength = (int32_t)Count;
+  }
+  ADS1220_SIM_CHECK(WrongLength < 0, "DecodeBatch (%s) differs from the scalar kernel at %ld samples",
+                    ADS1220_DecodeKernel(), (long)WrongLength);
+  ADS1220_SIM_CHECK(OverrunLength < 0, "DecodeBatch (%s) wrote past the output at %ld samples",
+                    ADS1220_DecodeKernel(), (long)OverrunLength);
+}
+
+// Filters at known points: 50/60Hz notch residual, exact CIC DC gain at full scale, median and moving average sequences
+#define ADS1220_SIM_FILTER_SPS      2000.0
+#define ADS1220_SIM_NOTCH_RESIDUAL  16      // Codes left of a 1e6-code tone at a notch frequency (Q2.29 coefficients)
+
+static void
+ADS1220_Sim_TestFilter (void)
+{
+  static const float Mains[2] = {50.0f, 60.0f};
+  static const int32_t Spiky[8] = {1, 2, 100, 3, 4, -50, 5, 6};
+  static const int32_t SpikyMedian[8] = {1, 1, 2, 2, 3, 3, 4, 4};
+  static const int32_t Ramp[6] = {10, 15, 20, 25, 35, 45}; // Average of 10, 20, ... 60 over the last 4 samples
+  static const int32_t FullScale[2] = {0x7FFFFF, -0x800000};
+  ADS1220_NotchBank_t Bank;
+  ADS1220_CIC_t CIC;
+  ADS1220_Median_t Median;
+  ADS1220_MovingAverage_t Average;
+  int32_t History[4];
+  int32_t Output;
+
+  for (uint8_t n = 0; n < 2; n++)
+  {
+    int32_t Residual = 0;
+    ADS1220_SIM_CHECK(ADS1220_NotchBankInit(&Bank, (float)ADS1220_SIM_FILTER_SPS, Mains, 2, 2.0f), "NotchBankInit failed");
+    for (uint16_t i = 0; i < 20000; i++)
+    {
+      int32_t Sample = 300000 + (int32_t)lround(1e6 * sin(2.0 * 3.14159265358979 * Mains[n] * i / ADS1220_SIM_FILTER_SPS));
+      int32_t Error = ADS1220_NotchBankUpdate(&Bank, Sample) - 300000; // DC passes, the tone is removed
+      if (i >= 15000 && abs(Error) > Residual) Residual = abs(Error);
+    }
+    ADS1220_SIM_CHECK(Residual <= ADS1220_SIM_NOTCH_RESIDUAL, "Notch %.0fHz residual %ld codes per 1e6", Mains[n], (long)Residual);
+  }
+
+  for (uint8_t n = 0; n < 2; n++)
+  {
+    uint16_t Outputs = 0, Wrong = 0;
+    ADS1220_SIM_CHECK(ADS1220_CICInit(&CIC, ADS1220_FILTER_CIC_ORDER_MAX, 40), "CICInit failed");
+    for (uint16_t i = 0; i < 40 * 10; i++)
+      if (ADS1220_CICUpdate(&CIC, FullScale[n], &Output) && ++Outputs > ADS1220_FILTER_CIC_ORDER_MAX && Output != FullScale[n]) Wrong++;
+    ADS1220_SIM_CHECK(Outputs == 10 && !Wrong, "CIC DC gain at %ld: %u outputs, %u wrong", (long)FullScale[n], Outputs, Wrong);
+  }
+
+  ADS1220_MedianInit(&Median, 5);
+  for (uint8_t i = 0; i < 8; i++)
+    ADS1220_SIM_CHECK((Output = ADS1220_MedianUpdate(&Median, Spiky[i])) == SpikyMedian[i], "Median %u: %ld", i, (long)Output);
+  ADS1220_MovingAverageInit(&Average, History, 4);
+  for (uint8_t i = 0; i < 6; i++)
+    ADS1220_SIM_CHECK((Output = ADS1220_MovingAverageUpdate(&Average, 10 * (i + 1))) == Ramp[i], "Average %u: %ld", i, (long)Output);
+}
+
+// RTD: Callendar-Van Dusen table against the formula, then 3-wire chopping over the simulator
+#define ADS1220_SIM_RTD_TABLE_ERROR 0.011   // C, interpolation error of a 10C table (See ADS1220_RTD_TABLE_STEP_C)
+
+// R(T) / R0 of IEC 60751 in double
+static double
+ADS1220_Sim_RTDRatio (double T)
+{
+  double Ratio = 1.0 + ADS1220_RTD_CVD_A * T + ADS1220_RTD_CVD_B * T * T;
+  return (T < 0.0) ? Ratio + ADS1220_RTD_CVD_C * (T - 100.0) * T * T * T : Ratio;
+}
+
+static void
+ADS1220_Sim_TestRTD (void)
+{
+  static ADS1220_SimBench_t Bench;
+  static ADS1220_RTDTable_t Table;
+  ADS1220_RTDConfig_t Config = {RTD3Wire, P1N2, _16_, ExternalREF0, _250uA_, AIN0REFP1, AIN3REFN1, 1620.0f, 100.0f, &Table};
+  ADS1220_RTD_t RTD;
+  float Temperature = 0.0f, Worst = 0.0f;
+  int16_t WorstAt = 0;
+
+  ADS1220_RTDTableInit(&Table, ADS1220_RTD_CVD_A, ADS1220_RTD_CVD_B, ADS1220_RTD_CVD_C);
+  Temperature = ADS1220_RTDTableLookup(&Table, 1.3851f);
+  ADS1220_SIM_CHECK(fabsf(Temperature - 100.012f) < 0.002f, "RTD table at ratio 1.3851: %.4fC", Temperature);
+  for (int16_t T = ADS1220_RTD_TABLE_MIN_C; T <= ADS1220_RTD_TABLE_MAX_C; T++)
+  {
+    float Error = fabsf(ADS1220_RTDTableLookup(&Table, (float)ADS1220_Sim_RTDRatio(T)) - (float)T);
+    if (Error > Worst) { Worst = Error; WorstAt = T; }
+  }
+  ADS1220_SIM_CHECK(Worst <= ADS1220_SIM_RTD_TABLE_ERROR, "RTD table error %.4fC at %dC", Worst, WorstAt);
+
+  // Chopping: IDAC1 and IDAC2 swap on every conversion and each output is the mean of the last two
+  // 3-wire: R = V * 2 * RREF / VREF with the reference resistor on REFP0/REFN0
+  ADS1220_SimBench_Setup(&Bench, 0x00, false, false);
+  ADS1220_SIM_CHECK(ADS1220_RTDInit(&RTD, &Config), "RTDInit failed");
+  ADS1220_Sim_SetInput(&Bench.Sim, P1N2, 130.0f * Bench.Sim.ExternalREF_V[0] / (2.0f * 1620.0f), 0.0f, 0.0f);
+  ADS1220_RTDStart(&Bench.Handler, &RTD);
+  ADS1220_SIM_CHECK(Bench.Sim.Reg[3] == RTD.Image[0][3], "RTDStart routing 0x%02X", Bench.Sim.Reg[3]);
+  ADS1220_SIM_CHECK(ADS1220_WaitDRDY(&Bench.Handler, RTD.Expected_US) == ResultOK && !ADS1220_RTDOnDRDY(&Bench.Handler, &RTD, &Temperature),
+                    "RTD chopping returned a temperature from one routing");
+  ADS1220_SIM_CHECK(Bench.Sim.Reg[3] == RTD.Image[1][3], "RTD routing was not swapped (0x%02X)", Bench.Sim.Reg[3]);
+  ADS1220_Sim_SetInput(&Bench.Sim, P1N2, 140.0f * Bench.Sim.ExternalREF_V[0] / (2.0f * 1620.0f), 0.0f, 0.0f);
+  ADS1220_SIM_CHECK(ADS1220_RTDRead(&Bench.Handler, &RTD, &Temperature) == ResultOK, "RTDRead timed out");
+  ADS1220_SIM_CHECK(Bench.Sim.Reg[3] == RTD.Image[0][3], "RTD routing was not swapped back (0x%02X)", Bench.Sim.Reg[3]);
+  ADS1220_SIM_CHECK(fabsf(RTD.Resistance - 135.0f) < 0.01f, "RTD chopped resistance %.4f Ohm, expected 135", RTD.Resistance);
+  ADS1220_SIM_CHECK(fabsf(Temperature - ADS1220_RTDTableLookup(&Table, 1.35f)) < 0.01f, "RTD chopped temperature %.4fC", Temperature);
+}
+
+// Type K at known points, then the cold-junction interleave over the simulator (Continuous conversion mode)
+#define ADS1220_SIM_TC_INTERVAL     16
+#define ADS1220_SIM_TC_CYCLES       4
+
+static void
+ADS1220_Sim_TestThermocouple (void)
+{
+  static ADS1220_SimBench_t Bench;
+  ADS1220_Thermocouple_t Thermocouple;
+  int32_t Temperature = 0;
+  uint16_t Hot = 0, Cold = 0;
+
+  ADS1220_SIM_CHECK(ADS1220_TypeKToMilliC(4096230) == 100000, "Type K at 4096230nV: %ld mC", (long)ADS1220_TypeKToMilliC(4096230));
+  ADS1220_SIM_CHECK(ADS1220_TypeKToNanoVolt(100000) == 4096230, "Type K at 100C: %ld nV", (long)ADS1220_TypeKToNanoVolt(100000));
+  ADS1220_SIM_CHECK(ADS1220_TypeKToNanoVolt(0) == 0, "Type K at 0C: %ld nV", (long)ADS1220_TypeKToNanoVolt(0));
+  ADS1220_SIM_CHECK(ADS1220_TempSensorToMilliC(800 * 1024) == 25000, "Temperature sensor 800 LSB: %ld mC",
+                    (long)ADS1220_TempSensorToMilliC(800 * 1024));
+
+  // Hot junction at 300C, cold junction at 25C: The input is E(300C) - E(25C)
+  ADS1220_SimBench_Setup(&Bench, (_1000_SPS_ << 5) | 0x04, false, false);
+  Bench.Sim.Temperature_C = 25.0f;
+  ADS1220_Sim_SetInput(&Bench.Sim, P0N1, (float)(ADS1220_TypeKToNanoVolt(300000) - ADS1220_TypeKToNanoVolt(25000)) * 1e-9f, 0.0f, 0.0f);
+  ADS1220_SIM_CHECK(ADS1220_ThermocoupleInit(&Thermocouple, P0N1, _32_, ADS1220_SIM_TC_INTERVAL), "ThermocoupleInit failed");
+  ADS1220_ThermocoupleStart(&Bench.Handler, &Thermocouple);
+  for (uint16_t i = 0; i < ADS1220_SIM_TC_CYCLES * (ADS1220_SIM_TC_INTERVAL + 1); i++)
+  {
+    if (ADS1220_WaitDRDY(&Bench.Handler, Thermocouple.Expected_US) != ResultOK) break;
+    if (Bench.Sim.ConvReg[1] & 0x02) Cold++; // Temperature sensor mode of the conversion that just ended
+    else Hot++;
+    ADS1220_ThermocoupleOnDRDY(&Bench.Handler, &Thermocouple, &Temperature);
+  }
+  ADS1220_SIM_CHECK(Cold == ADS1220_SIM_TC_CYCLES && Hot == ADS1220_SIM_TC_CYCLES * ADS1220_SIM_TC_INTERVAL,
+                    "Thermocouple interleave: %u cold-junction and %u thermocouple conversions", Cold, Hot);
+  ADS1220_SIM_CHECK(Thermocouple.ColdJunction_mC == 25000, "Cold junction %ld mC", (long)Thermocouple.ColdJunction_mC);
+  ADS1220_SIM_CHECK(labs(Temperature - 300000) <= 50, "Thermocouple at 300C: %ld mC", (long)Temperature);
+}
+
+// Fixed-point conversions against the float macros: at most half an output unit off over the whole ADC range
+static void
+ADS1220_Sim_TestFixed (void)
+{
+  double Error[ADS1220_SIM_FIXED_CASES];
+
+  ADS1220_Sim_FixedAccuracy(Error);
+  for (uint8_t i = 0; i < ADS1220_SIM_FIXED_CASES; i++)
+    ADS1220_SIM_CHECK(Error[i] >= 0.0 && Error[i] <= ADS1220_SIM_FIXED_LSB,
+                      "Fixed %s: max error %.4f LSB", ADS1220_SimFixedName[i], Error[i]);
+}
+
+static int
+ADS1220_Sim_Test (void)
+{
+  ADS1220_Sim_TestStats();
+  ADS1220_Sim_TestDelayBudget();
+  ADS1220_Sim_TestInitFast();
+  ADS1220_Sim_TestStreamTimeout();
+  ADS1220_Sim_TestStream();
+  ADS1220_Sim_TestOversampled();
+  ADS1220_Sim_TestAutoRangeTimeout();
+  ADS1220_Sim_TestBusDOUT();
+  ADS1220_Sim_TestFixed();
+  ADS1220_Sim_TestDecode();
+  ADS1220_Sim_TestFilter();
+  ADS1220_Sim_TestRTD();
+  ADS1220_Sim_TestThermocouple();
+  printf("%u checks, %u failures\r\n", ADS1220_SimTestChecks, ADS1220_SimTestFailures);
+  return ADS1220_SimTestFailures;
+}
+
+int
+main(int argc, char *argv[])
+{
+  if (argc > 1 && !strcmp(argv[1], "test"))
+    return ADS1220_Sim_Test();
+
+  if (argc > 1 && !strcmp(argv[1], "fixed"))
+  {
+    double Error[ADS1220_SIM_FIXED_CASES];
+    ADS1220_Sim_FixedAccuracy(Error);
+    for (uint8_t i = 0; i < ADS1220_SIM_FIXED_CASES; i++)
+      printf("%-11s max error %.4f LSB\r\n", ADS1220_SimFixedName[i], Error[i]);
+    return 0;
+  }
+
+  if (argc > 1 && (!strcmp(argv[1], "csv") || !strcmp(argv[1], "json")))
+  {
+    static ADS1220_SimThroughput_t Matrix[ADS1220_SIM_THROUGHPUT_RESULTS];
+    uint16_t Entries = ADS1220_Sim_Throughput(Matrix, ADS1220_SIM_THROUGHPUT_RESULTS, (argc > 2) ? (uint8_t)atoi(argv[2]) : 4);
+    if (Entries > ADS1220_SIM_THROUGHPUT_RESULTS)
+    {
+      fprintf(stderr, "Throughput matrix needs %u entries, buffer has %u\r\n", Entries, (unsigned)ADS1220_SIM_THROUGHPUT_RESULTS);
+      return 1;
+    }
+    ADS1220_Sim_PrintThroughput(Matrix, Entries, strcmp(argv[1], "csv") ? SimJSON : SimCSV);
+    return 0;
+  }
+
+  ADS1220_SimBenchResult_t Results[32];
+  uint8_t Count = ADS1220_Sim_Benchmark(Results, 32);
+  ADS1220_Sim_PrintBenchmark(Results, Count);
+
+  printf("\r\nBus scheduler, 1000SPS Normal mode, Single-shot:\r\n");
+  for (uint8_t Devices = 1; Devices <= 8; Devices <<= 1)
+    printf("%u device(s): %.1f SPS aggregate\r\n", Devices, ADS1220_Sim_BusBenchmark(Devices, (_1000_SPS_ << 5), 200));
+  return 0;
+}
+#endif
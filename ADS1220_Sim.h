@@ -0,0 +1,317 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_Sim.h
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Host-side behavioural simulator of ADS1220 and SPI-cost benchmark
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Define to prevent recursive inclusion ---------------------------------------- //
+#ifndef ADS1220_SIM_H
+#define ADS1220_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//* Includes ---------------------------------------------------------------------- //
+#include "ADS1220.h"
+
+//? User Configurations and Notes ------------------------------------------------- //
+// This module is for host builds only (depends on math.h and stdio.h).
+// Build the benchmark: cc -O2 -DADS1220_SIM_MAIN ADS1220.c ADS1220_Fixed.c ADS1220_Sim.c -lm -o ads1220_bench
+// Throughput matrix:   ./ads1220_bench csv [Passes] | ./ads1220_bench json [Passes]
+#define ADS1220_SIM_POLL_STEP_NS        1000 // Simulated time of one DRDY poll (ADS1220_Sim_DRDY, ADS1220_Sim_MISO)
+//? ------------------------------------------------------------------------------- //
+
+/**
+ ** ==================================================================================
+ **                                ##### Enums #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Output format of ADS1220_Sim_PrintThroughput
+ */
+typedef enum
+ADS1220_SimFormat_e {
+  SimCSV  = 0,
+  SimJSON = 1
+} ADS1220_SimFormat_t;
+
+/**
+ ** ==================================================================================
+ **                               ##### Structs #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Input waveform of one Input Multiplexer setting: Offset + Amplitude * sin(2 * pi * Frequency * t)
+ * @note   Voltages are AINP - AINN in Volt.
+ */
+typedef struct
+ADS1220_SimInput_s {
+  float Offset_V;
+  float Amplitude_V;
+  float Frequency_Hz;
+} ADS1220_SimInput_t;
+
+/**
+ * @brief  Simulated time and cost counters (Shared by all devices on one bus)
+ */
+typedef struct
+ADS1220_SimClock_s {
+  uint64_t Now_NS;                      // Simulated wall time
+  uint64_t SPI_NS;                      // Time spent shifting bytes on SPI
+  uint64_t Delay_NS;                    // Time spent in ADC_Delay_US
+  uint64_t DRDYWait_NS;                 // Time spent polling a HIGH DRDY
+  uint32_t SPIBytes;                    // Number of bytes on SPI
+  uint32_t CSToggles;                   // Number of CS edges
+  uint32_t DelayCalls;                  // Number of ADC_Delay_US calls
+  uint32_t Samples;                     // Number of conversion results read
+  uint32_t SPIClock_Hz;                 // SPI clock (SCLK) frequency
+} ADS1220_SimClock_t;
+
+/**
+ * @brief  Simulated ADS1220
+ * @note   Use ADS1220_Sim_Init to initialize it, and ADS1220_Sim_Attach to connect it to a handler.
+ */
+typedef struct
+ADS1220_Sim_s {
+  ADS1220_SimClock_t *Clock;            // Pointer Of shared Clock
+  ADS1220_SimInput_t Input[16];         // Input waveform of each ADS1220_InputMuxConfig setting
+  float    ExternalREF_V[2];            // REFP0 - REFN0 and REFP1 - REFN1 in Volt
+  float    AVDD_V;                      // AVDD - AVSS in Volt
+  float    Temperature_C;               // Die temperature for temperature sensor mode
+  uint8_t  Reg[4];                      // Register file (REG00h - REG03h)
+  uint8_t  CS;                          // CS level
+  bool     Converting;                  // true: A conversion is in progress
+  bool     DataReady;                   // true: DRDY is LOW
+  uint8_t  ConvReg[4];                  // Registers when the running conversion started
+  uint64_t ConversionEnd_NS;            // End time of the running conversion
+  int32_t  Data;                        // Output data register
+  uint32_t Conversions;                 // Number of finished conversions
+  uint32_t Overruns;                    // Number of conversion results overwritten before they were read
+} ADS1220_Sim_t;
+
+/**
+ * @brief  Benchmark result of one public function
+ */
+typedef struct
+ADS1220_SimBenchResult_s {
+  const char *Name;                     // Function name
+  uint32_t SPIBytes;                    // Number of bytes on SPI
+  uint32_t CSToggles;                   // Number of CS edges
+  uint32_t Delay_US;                    // MicroSeconds of delay requested
+  uint32_t DRDYWait_US;                 // MicroSeconds spent waiting for DRDY
+  uint32_t SPI_US;                      // MicroSeconds spent shifting bytes on SPI
+  uint32_t Wall_US;                     // Simulated wall time in MicroSecond
+} ADS1220_SimBenchResult_t;
+
+/**
+ * @brief  Effective throughput of one acquisition path at one Data rate and Operating mode
+ */
+typedef struct
+ADS1220_SimThroughput_s {
+  const char *Path;                     // Acquisition path
+  ADS1220_DataRate_t      DataRate;     // See ADS1220_DataRate enum
+  ADS1220_OperatingMode_t OperatingMode;// See ADS1220_OperatingMode enum
+  uint8_t  Channels;                    // Channels read by one pass of the path
+  float    Nominal_SPS;                 // Output data rate of the configuration
+  float    Theoretical_SPS;             // Nominal_SPS / Channels
+  float    Achieved_SPS;                // Achieved samples per second per channel
+  float    Gap_Percent;                 // 100 * (1 - Achieved_SPS / Theoretical_SPS)
+  uint32_t Delay_US;                    // MicroSeconds of delay requested
+  uint32_t DRDYWait_US;                 // MicroSeconds spent waiting for DRDY
+  uint32_t SPI_US;                      // MicroSeconds spent shifting bytes on SPI
+  uint32_t Wall_US;                     // Simulated wall time in MicroSecond
+} ADS1220_SimThroughput_t;
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Initializes a Clock
+ * @note   The Clock becomes the active clock of ADS1220_Sim_Delay_US.
+ * @param  Clock:       Pointer Of Clock
+ * @param  SPIClock_Hz: SPI clock (SCLK) frequency in Hz
+ * @retval None
+ */
+void
+ADS1220_Sim_ClockInit(ADS1220_SimClock_t *Clock, uint32_t SPIClock_Hz);
+
+/**
+ * @brief  Resets the cost counters of a Clock (Simulated time keeps running)
+ * @param  Clock:       Pointer Of Clock
+ * @retval None
+ */
+void
+ADS1220_Sim_ClockResetStats(ADS1220_SimClock_t *Clock);
+
+/**
+ * @brief  Initializes a simulated ADS1220 at power up
+ * @note   All inputs are 0V, external references are 2.5V, AVDD is 3.3V and temperature is 25C.
+ * @param  Sim:         Pointer Of Simulated ADS1220
+ * @param  Clock:       Pointer Of Clock
+ * @retval None
+ */
+void
+ADS1220_Sim_Init(ADS1220_Sim_t *Sim, ADS1220_SimClock_t *Clock);
+
+/**
+ * @brief  Connects a simulated ADS1220 to a Library Handler
+ * @note   Sets Context, ADC_Transfer, ADC_CS_Write, ADC_DRDY_Get, ADC_Delay_US and ADC_GetTime_US.
+ * @param  ADC_Handler: Pointer Of Library Handler
+ * @param  Sim:         Pointer Of Simulated ADS1220
+ * @retval None
+ */
+void
+ADS1220_Sim_Attach(ADS1220_Handler_t *ADC_Handler, ADS1220_Sim_t *Sim);
+
+/**
+ * @brief  Sets the input waveform of one Input Multiplexer setting
+ * @param  Sim:          Pointer Of Simulated ADS1220
+ * @param  Mux:          See ADS1220_InputMuxConfig enum
+ * @param  Offset_V:     DC level in Volt
+ * @param  Amplitude_V:  Sine amplitude in Volt
+ * @param  Frequency_Hz: Sine frequency in Hz
+ * @retval None
+ */
+void
+ADS1220_Sim_SetInput(ADS1220_Sim_t *Sim, ADS1220_InputMuxConfig_t Mux, float Offset_V, float Amplitude_V, float Frequency_Hz);
+
+/**
+ * @brief  Advances the simulated time
+ * @param  Clock:       Pointer Of Clock
+ * @param  Time_NS:     Time in NanoSecond
+ * @retval None
+ */
+void
+ADS1220_Sim_Advance(ADS1220_SimClock_t *Clock, uint64_t Time_NS);
+
+/**
+ * @brief  Output data rate of a configuration in SPS
+ * @param  Reg01h:      REG01h value
+ * @retval Output data rate
+ */
+float
+ADS1220_Sim_DataRate(uint8_t Reg01h);
+
+/**
+ * @brief  ADC_Transfer callback of the simulator (Context: Pointer Of Simulated ADS1220)
+ */
+void
+ADS1220_Sim_Transfer(void *Context, const uint8_t *TxData, uint8_t *RxData, uint16_t Length);
+
+/**
+ * @brief  ADC_CS_Write callback of the simulator (Context: Pointer Of Simulated ADS1220)
+ */
+void
+ADS1220_Sim_CS(void *Context, uint8_t Level);
+
+/**
+ * @brief  ADC_DRDY_Get callback of the simulator (Context: Pointer Of Simulated ADS1220)
+ * @note   Each call that returns HIGH advances the Clock by ADS1220_SIM_POLL_STEP_NS.
+ */
+uint8_t
+ADS1220_Sim_DRDY(void *Context);
+
+/**
+ * @brief  ADC_MISO_Get callback of the simulator (Context: Pointer Of Simulated ADS1220)
+ * @note   DOUT/DRDY is LOW only while CS is LOW, DRDYM = 1 and data is ready.
+ *         Each call that returns HIGH advances the Clock by ADS1220_SIM_POLL_STEP_NS.
+ */
+uint8_t
+ADS1220_Sim_MISO(void *Context);
+
+/**
+ * @brief  ADC_Delay_US callback of the simulator (Advances the active Clock)
+ */
+void
+ADS1220_Sim_Delay_US(uint32_t Delay_US);
+
+/**
+ * @brief  ADC_GetTime_US callback of the simulator (Context: Pointer Of Simulated ADS1220)
+ */
+uint32_t
+ADS1220_Sim_GetTime_US(void *Context);
+
+/**
+ * @brief  Runs every public function of the library on a fresh simulated ADS1220 and records its cost
+ * @param  Results:     Pointer Of Results Array
+ * @param  MaxResults:  Number of Elements of Results
+ * @retval Number of results
+ */
+uint8_t
+ADS1220_Sim_Benchmark(ADS1220_SimBenchResult_t *Results, uint8_t MaxResults);
+
+/**
+ * @brief  Measures the aggregate sample rate of N simulated ADS1220s on one bus (ADS1220_BusReadAll)
+ * @param  Count:       Number of Devices (1 - 32)
+ * @param  Reg01h:      REG01h of all devices (Data rate, Operating and Conversion mode)
+ * @param  Duration_MS: Simulated duration in MilliSecond
+ * @retval Aggregate samples per second
+ */
+float
+ADS1220_Sim_BusBenchmark(uint8_t Count, uint8_t Reg01h, uint32_t Duration_MS);
+
+/**
+ * @brief  Prints benchmark results as a table (stdout)
+ * @param  Results:     Pointer Of Results Array
+ * @param  Count:       Number of results
+ * @retval None
+ */
+void
+ADS1220_Sim_PrintBenchmark(const ADS1220_SimBenchResult_t *Results, uint8_t Count);
+
+/**
+ * @brief  Measures effective throughput of every acquisition path at every Data rate and Operating mode
+ * @note   Each entry runs one warm-up pass, then Passes measured passes, on a fresh simulated ADS1220.
+ *         Theoretical_SPS is the nominal data rate shared by the channels of the path.
+ * @param  Results:     Pointer Of Results Array
+ * @param  MaxResults:  Number of Elements of Results
+ * @param  Passes:      Number of measured passes of each path (Samples per channel)
+ * @retval Number of results of the whole matrix | If it is more than MaxResults, only the first MaxResults are measured
+ */
+uint16_t
+ADS1220_Sim_Throughput(ADS1220_SimThroughput_t *Results, uint16_t MaxResults, uint8_t Passes);
+
+/**
+ * @brief  Prints throughput results as CSV or JSON (stdout)
+ * @param  Results:     Pointer Of Results Array
+ * @param  Count:       Number of results
+ * @param  Format:      See ADS1220_SimFormat enum
+ * @retval None
+ */
+void
+ADS1220_Sim_PrintThroughput(const ADS1220_SimThroughput_t *Results, uint16_t Count, ADS1220_SimFormat_t Format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,232 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_Thermocouple.c
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Thermocouple measurement with interleaved cold-junction compensation
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Private Includes -------------------------------------------------------------- //
+#include "ADS1220_Thermocouple.h"
+
+//* Private Defines and Macros ---------------------------------------------------- //
+#define ADS1220_TYPEK_MIN_mC        -270000
+#define ADS1220_TYPEK_STEP_mC       10000
+#define ADS1220_TYPEK_SIZE          165
+#define ADS1220_TC_VREF_nV          2048000000LL // Internal reference
+
+/**
+ *! ==================================================================================
+ *!                                ##### Tables #####
+ *! ==================================================================================
+ **/
+
+// Type K voltage in NanoVolt at -270C + i * 10C (NIST ITS-90 reference polynomials)
+static const int32_t ADS1220_TypeK_nV[ADS1220_TYPEK_SIZE] = {
+   -6457738,  -6441090,  -6403606,  -6343828,  -6261838,  -6158424,  -6034608,  -5891404,
+   -5729720,  -5550347,  -5353976,  -5141233,  -4912708,  -4668978,  -4410619,  -4138211,
+   -3852348,  -3553631,  -3242679,  -2920126,  -2586621,  -2242821,  -1889383,  -1526948,
+   -1156131,   -777540,   -391854,         0,    396862,    798120,   1203275,   1611792,
+    2023078,   2436472,   2851249,   3266642,   3681879,   4096230,   4509060,   4919882,
+    5328395,   5734508,   6138344,   6540216,   6940588,   7340023,   7739124,   8138473,
+    8538590,   8939893,   9342685,   9747152,  10153369,  10561326,  10970948,  11382118,
+   11794703,  12208566,  12623577,  13039627,  13456620,  13874481,  14293149,  14712576,
+   15132723,  15553553,  15975037,  16397142,  16819837,  17243088,  17666860,  18091113,
+   18515807,  18940899,  19366342,  19792087,  20218086,  20644286,  21070635,  21497078,
+   21923562,  22350030,  22776428,  23202702,  23628796,  24054656,  24480231,  24905467,
+   25330315,  25754724,  26178649,  26602043,  27024863,  27447068,  27868617,  28289474,
+   28709604,  29128974,  29547554,  29965317,  30382236,  30798289,  31213454,  31627713,
+   32041049,  32453447,  32864894,  33275380,  33684895,  34093431,  34500981,  34907541,
+   35313106,  35717673,  36121240,  36523803,  36925362,  37325915,  37725461,  38123998,
+   38521524,  38918036,  39313533,  39708009,  40101461,  40493883,  40885267,  41275606,
+   41664891,  42053111,  42440253,  42826304,  43211248,  43595069,  43977749,  44359268,
+   44739604,  45118736,  45496639,  45873290,  46248663,  46622731,  46995468,  47366846,
+   47736839,  48105419,  48472560,  48838238,  49202427,  49565105,  49926251,  50285848,
+   50643879,  51000333,  51355201,  51708479,  52060168,  52410275,  52758810,  53105793,
+   53451248,  53795208,  54137714,  54478814,  54818569
+};
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Converts an internal temperature sensor result (14-bit, 0.03125C per LSB) to milli C
+ * @param  ADCSample:   ADC value read in temperature sensor mode
+ * @retval Temperature in milli C
+ */
+int32_t
+ADS1220_TempSensorToMilliC(int32_t ADCSample)
+{
+  return ADCSample / 1024 * 125 / 4; // 14-bit left-justified result
+}
+
+/**
+ * @brief  Type K thermocouple voltage of a temperature (Reference junction at 0C)
+ * @param  Temperature_mC: Temperature in milli C
+ * @retval Voltage in NanoVolt
+ */
+int32_t
+ADS1220_TypeKToNanoVolt(int32_t Temperature_mC)
+{
+  int32_t Offset = Temperature_mC - ADS1220_TYPEK_MIN_mC;
+  int32_t Index = Offset / ADS1220_TYPEK_STEP_mC;
+  if (Offset < 0) Index = 0;
+  if (Index > ADS1220_TYPEK_SIZE - 2) Index = ADS1220_TYPEK_SIZE - 2;
+  Offset -= Index * ADS1220_TYPEK_STEP_mC;
+  return ADS1220_TypeK_nV[Index] +
+         (int32_t)((int64_t)(ADS1220_TypeK_nV[Index + 1] - ADS1220_TypeK_nV[Index]) * Offset / ADS1220_TYPEK_STEP_mC);
+}
+
+/**
+ * @brief  Temperature of a Type K thermocouple voltage (Reference junction at 0C)
+ * @param  Voltage_nV:  Voltage in NanoVolt
+ * @retval Temperature in milli C
+ */
+int32_t
+ADS1220_TypeKToMilliC(int32_t Voltage_nV)
+{
+  uint8_t Low = 0, High = ADS1220_TYPEK_SIZE - 1;
+  while (High - Low > 1)
+  {
+    uint8_t Middle = (Low + High) / 2;
+    if (ADS1220_TypeK_nV[Middle] <= Voltage_nV) Low = Middle;
+    else High = Middle;
+  }
+  return ADS1220_TYPEK_MIN_mC + Low * ADS1220_TYPEK_STEP_mC +
+         (int32_t)((int64_t)(Voltage_nV - ADS1220_TypeK_nV[Low]) * ADS1220_TYPEK_STEP_mC / (ADS1220_TypeK_nV[High] - ADS1220_TypeK_nV[Low]));
+}
+
+/**
+ * @brief  Initializes a Type K thermocouple measurement
+ * @param  Thermocouple: Pointer Of Thermocouple State
+ * @param  InputMux:     Thermocouple input | See ADS1220_InputMuxConfig enum
+ * @param  Gain:         See ADS1220_GainConfig enum
+ * @param  Interval:     Thermocouple conversions per cold-junction conversion (E.g. ADS1220_TC_CJC_INTERVAL)
+ *                       - Every cold-junction update costs about 2 conversions in Continuous conversion mode
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_ThermocoupleInit(ADS1220_Thermocouple_t *Thermocouple, ADS1220_InputMuxConfig_t InputMux, ADS1220_GainConfig_t Gain, uint16_t Interval)
+{
+  if (!Interval || InputMux > P3NAVSS) return false;
+  Thermocouple->InputMux = InputMux;
+  Thermocouple->Gain = Gain;
+  Thermocouple->Interval = Interval;
+  Thermocouple->Count = 0;
+  Thermocouple->ColdJunction_mC = 0;
+  Thermocouple->Voltage_nV = 0;
+  Thermocouple->ColdJunctionValid = false;
+  return true;
+}
+
+/**
+ * @brief  Configures ADS1220 and starts with a cold-junction conversion
+ * @note   Data rate, operating mode, conversion mode and FIR filter are kept. IDACs are disabled.
+ * @param  ADC_Handler:  Pointer Of Library Handler
+ * @param  Thermocouple: Pointer Of Thermocouple State
+ * @retval None
+ */
+void
+ADS1220_ThermocoupleStart(ADS1220_Handler_t *ADC_Handler, ADS1220_Thermocouple_t *Thermocouple)
+{
+  ADS1220_ConversionTiming_t Timing;
+  uint8_t *Image = Thermocouple->Image[0];
+
+  Image[0] = (Thermocouple->InputMux << 4) | (Thermocouple->Gain << 1);
+  Image[1] = ADC_Handler->RegShadow[1] & ~0x02;
+  Image[2] = ADC_Handler->RegShadow[2] & 0x38;   // Internal reference, IDACs off
+  Image[3] = ADC_Handler->RegShadow[3] & 0x03;
+  for (uint8_t i = 0; i < 4; i++) Thermocouple->Image[1][i] = Image[i];
+  Thermocouple->Image[1][1] |= 0x02;             // Temperature sensor mode
+
+  ADS1220_GetConversionTiming((ADS1220_DataRate_t)(Image[1] >> 5), (ADS1220_OperatingMode_t)((Image[1] >> 3) & 0x03),
+                              ADS1220_FCLK_HZ, &Timing);
+  Thermocouple->Period_US = Timing.Period_US;
+  Thermocouple->FirstConversion_US = Timing.FirstConversion_US;
+  Thermocouple->Expected_US = Timing.FirstConversion_US;
+  Thermocouple->Count = 0;
+  Thermocouple->Running = 1;
+  ADS1220_WriteImage(ADC_Handler, Thermocouple->Image[1]);
+  ADS1220_StartSync(ADC_Handler);
+}
+
+/**
+ * @brief  Reads one conversion and writes the next conversion type in the same frame (Only when it changes)
+ * @note   Call it when DRDY goes LOW. In Single-shot mode the next conversion is started.
+ * @param  ADC_Handler:    Pointer Of Library Handler
+ * @param  Thermocouple:   Pointer Of Thermocouple State
+ * @param  Temperature_mC: Pointer Of hot-junction temperature in milli C
+ * @retval true: Temperature is written (false after a cold-junction conversion)
+ */
+bool
+ADS1220_ThermocoupleOnDRDY(ADS1220_Handler_t *ADC_Handler, ADS1220_Thermocouple_t *Thermocouple, int32_t *Temperature_mC)
+{
+  uint8_t Running = Thermocouple->Running;
+  uint8_t Next = 0;
+  bool Written;
+  int32_t Sample;
+
+  if (Running) Thermocouple->Count = 0;
+  else if (++Thermocouple->Count >= Thermocouple->Interval) Next = 1;
+
+  Written = ADS1220_ReadDataWriteImage(ADC_Handler, Thermocouple->Image[Next], &Sample);
+  Thermocouple->Running = Next;
+  if (ADS1220_GetPowerState(ADC_Handler) != StateContinuous)
+  {
+    ADS1220_StartSync(ADC_Handler);
+    Thermocouple->Expected_US = Thermocouple->FirstConversion_US;
+  }
+  else Thermocouple->Expected_US = Written ? Thermocouple->FirstConversion_US : Thermocouple->Period_US;
+
+  if (Running)
+  {
+    Thermocouple->ColdJunction_mC = ADS1220_TempSensorToMilliC(Sample);
+    Thermocouple->ColdJunctionValid = true;
+    return false;
+  }
+  Thermocouple->Voltage_nV = (int32_t)((int64_t)Sample * ADS1220_TC_VREF_nV / ((int64_t)1 << (23 + Thermocouple->Gain)));
+  if (!Thermocouple->ColdJunctionValid) return false;
+  *Temperature_mC = ADS1220_TypeKToMilliC(Thermocouple->Voltage_nV + ADS1220_TypeKToNanoVolt(Thermocouple->ColdJunction_mC));
+  return true;
+}
+
+/**
+ * @brief  Waits for the next hot-junction temperature (Blocking, see ADS1220_WaitDRDY)
+ * @param  ADC_Handler:    Pointer Of Library Handler
+ * @param  Thermocouple:   Pointer Of Thermocouple State
+ * @param  Temperature_mC: Pointer Of hot-junction temperature in milli C
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time
+ */
+ADS1220_Result_t
+ADS1220_ThermocoupleRead(ADS1220_Handler_t *ADC_Handler, ADS1220_Thermocouple_t *Thermocouple, int32_t *Temperature_mC)
+{
+  do
+  {
+    if (ADS1220_WaitDRDY(ADC_Handler, Thermocouple->Expected_US) != ResultOK) return ResultTimeout;
+  } while (!ADS1220_ThermocoupleOnDRDY(ADC_Handler, Thermocouple, Temperature_mC));
+  return ResultOK;
+}
@@ -0,0 +1,154 @@
+/**
+ **********************************************************************************
+ * @file   ADS1220_Thermocouple.h
+ * @author Ali Moallem (https://github.com/AliMoal)
+ * @brief  Thermocouple measurement with interleaved cold-junction compensation
+ **********************************************************************************
+ *
+ *! Copyright (c) 2022 Mahda Embedded System (MIT License)
+ *!
+ *! Permission is hereby granted, free of charge, to any person obtaining a copy
+ *! of this software and associated documentation files (the "Software"), to deal
+ *! in the Software without restriction, including without limitation the rights
+ *! to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *! copies of the Software, and to permit persons to whom the Software is
+ *! furnished to do so, subject to the following conditions:
+ *!
+ *! The above copyright notice and this permission notice shall be included in all
+ *! copies or substantial portions of the Software.
+ *!
+ *! THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *! IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *! FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *! AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *! LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *! OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *! SOFTWARE.
+ *!
+ **********************************************************************************
+ **/
+//* Define to prevent recursive inclusion ---------------------------------------- //
+#ifndef ADS1220_THERMOCOUPLE_H
+#define ADS1220_THERMOCOUPLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//* Includes ---------------------------------------------------------------------- //
+#include "ADS1220.h"
+
+//? User Configurations and Notes ------------------------------------------------- //
+// The thermocouple is measured against the internal 2.048V reference with the PGA enabled. Its input must be biased
+// inside the PGA input range (E.g. AINN to mid-supply). Conversions are fixed point only (No float, no math.h).
+// Type K uses a table of the NIST ITS-90 polynomials from -270C to 1370C in 10C steps. Interpolation error is
+// < 0.015C above 0C, < 0.14C above -200C and < 1.6C below -200C.
+#define ADS1220_TC_CJC_INTERVAL         64   // Default thermocouple conversions per cold-junction conversion (See ADS1220_ThermocoupleInit)
+//? ------------------------------------------------------------------------------- //
+
+/**
+ ** ==================================================================================
+ **                               ##### Structs #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Thermocouple measurement state
+ * @note   The thermocouple and the internal temperature sensor conversions differ only by REG01h, so switching
+ *         is a 1-byte WREG written in the same frame that reads the previous conversion. Thermocouple conversions
+ *         in a row need no write, so Continuous conversion mode runs at the full data rate between CJC updates.
+ */
+typedef struct
+ADS1220_Thermocouple_s {
+  uint8_t  Image[2][4];                  // [0]: Thermocouple | [1]: Internal temperature sensor (Built by ADS1220_ThermocoupleStart)
+  int32_t  ColdJunction_mC;              // Last cold-junction temperature in milli C
+  int32_t  Voltage_nV;                   // Last thermocouple voltage in NanoVolt
+  uint32_t Period_US;                    // Conversion time without a register write
+  uint32_t FirstConversion_US;           // Conversion time after a register write
+  uint32_t Expected_US;                  // Conversion time of the running conversion
+  uint16_t Interval;                     // Thermocouple conversions per cold-junction conversion
+  uint16_t Count;                        // Thermocouple conversions since the last cold-junction conversion
+  ADS1220_InputMuxConfig_t InputMux;
+  ADS1220_GainConfig_t     Gain;
+  uint8_t  Running;                      // Image of the running conversion
+  bool     ColdJunctionValid;
+} ADS1220_Thermocouple_t;
+
+/**
+ ** ==================================================================================
+ **                           ##### Public Functions #####
+ ** ==================================================================================
+ **/
+
+/**
+ * @brief  Converts an internal temperature sensor result (14-bit, 0.03125C per LSB) to milli C
+ * @param  ADCSample:   ADC value read in temperature sensor mode
+ * @retval Temperature in milli C
+ */
+int32_t
+ADS1220_TempSensorToMilliC(int32_t ADCSample);
+
+/**
+ * @brief  Type K thermocouple voltage of a temperature (Reference junction at 0C)
+ * @param  Temperature_mC: Temperature in milli C
+ * @retval Voltage in NanoVolt
+ */
+int32_t
+ADS1220_TypeKToNanoVolt(int32_t Temperature_mC);
+
+/**
+ * @brief  Temperature of a Type K thermocouple voltage (Reference junction at 0C)
+ * @param  Voltage_nV:  Voltage in NanoVolt
+ * @retval Temperature in milli C
+ */
+int32_t
+ADS1220_TypeKToMilliC(int32_t Voltage_nV);
+
+/**
+ * @brief  Initializes a Type K thermocouple measurement
+ * @param  Thermocouple: Pointer Of Thermocouple State
+ * @param  InputMux:     Thermocouple input | See ADS1220_InputMuxConfig enum
+ * @param  Gain:         See ADS1220_GainConfig enum
+ * @param  Interval:     Thermocouple conversions per cold-junction conversion (E.g. ADS1220_TC_CJC_INTERVAL)
+ *                       - Every cold-junction update costs about 2 conversions in Continuous conversion mode
+ * @retval false: Invalid arguments
+ */
+bool
+ADS1220_ThermocoupleInit(ADS1220_Thermocouple_t *Thermocouple, ADS1220_InputMuxConfig_t InputMux, ADS1220_GainConfig_t Gain, uint16_t Interval);
+
+/**
+ * @brief  Configures ADS1220 and starts with a cold-junction conversion
+ * @note   Data rate, operating mode, conversion mode and FIR filter are kept. IDACs are disabled.
+ * @param  ADC_Handler:  Pointer Of Library Handler
+ * @param  Thermocouple: Pointer Of Thermocouple State
+ * @retval None
+ */
+void
+ADS1220_ThermocoupleStart(ADS1220_Handler_t *ADC_Handler, ADS1220_Thermocouple_t *Thermocouple);
+
+/**
+ * @brief  Reads one conversion and writes the next conversion type in the same frame (Only when it changes)
+ * @note   Call it when DRDY goes LOW. In Single-shot mode the next conversion is started.
+ * @param  ADC_Handler:    Pointer Of Library Handler
+ * @param  Thermocouple:   Pointer Of Thermocouple State
+ * @param  Temperature_mC: Pointer Of hot-junction temperature in milli C
+ * @retval true: Temperature is written (false after a cold-junction conversion)
+ */
+bool
+ADS1220_ThermocoupleOnDRDY(ADS1220_Handler_t *ADC_Handler, ADS1220_Thermocouple_t *Thermocouple, int32_t *Temperature_mC);
+
+/**
+ * @brief  Waits for the next hot-junction temperature (Blocking, see ADS1220_WaitDRDY)
+ * @param  ADC_Handler:    Pointer Of Library Handler
+ * @param  Thermocouple:   Pointer Of Thermocouple State
+ * @param  Temperature_mC: Pointer Of hot-junction temperature in milli C
+ * @retval ResultOK | ResultTimeout: DRDY did not go LOW in time
+ */
+ADS1220_Result_t
+ADS1220_ThermocoupleRead(ADS1220_Handler_t *ADC_Handler, ADS1220_Thermocouple_t *Thermocouple, int32_t *Temperature_mC);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif